@@ -0,0 +1,40 @@
+#include "Allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+namespace
+{
+	std::atomic<uint64_t> allocations{ 0 };
+}
+
+// The array and nothrow forms call these, so replacing them counts every unaligned allocation.
+void* operator new(std::size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (auto p = std::malloc(size != 0 ? size : 1))
+		return p;
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace Rml::SolLua::Bench
+{
+
+	uint64_t GetAllocationCount()
+	{
+		return allocations.load(std::memory_order_relaxed);
+	}
+
+} // end namespace Rml::SolLua::Bench
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace Rml::SolLua::Bench
+{
+	/// <summary>
+	/// Gets the number of C++ heap allocations made by the benchmark executable so far.
+	/// Counted by replacing the global operator new.  Lua's own allocations are not included.
+	/// </summary>
+	uint64_t GetAllocationCount();
+
+} // end namespace Rml::SolLua::Bench
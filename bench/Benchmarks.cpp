@@ -0,0 +1,649 @@
+#include "Allocations.h"
+#include "Headless.h"
+
+#include <RmlSolLua/RmlSolLua.h>
+
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/ElementDocument.h>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <utility>
+
+
+namespace Rml::SolLua::Bench
+{
+
+	namespace
+	{
+		/// <summary>
+		/// Builds a document with a number of items, each with an inline click listener.
+		/// </summary>
+		Rml::String makeItems(int64_t count)
+		{
+			Rml::String rml;
+			for (int64_t i = 1; i <= count; ++i)
+			{
+				const auto index = std::to_string(i);
+				rml.append("<div class=\"item\" id=\"item");
+				rml.append(index);
+				rml.append("\" onclick=\"clicks = clicks + 1\">");
+				rml.append(index);
+				rml.append("</div>\n");
+			}
+			return rml;
+		}
+
+		Rml::String makeDocument(const Rml::String& head, const Rml::String& body, const char* body_attributes = "")
+		{
+			Rml::String rml{ "<rml>\n<head>\n" };
+			rml.append(head);
+			rml.append("</head>\n<body ");
+			rml.append(body_attributes);
+			rml.append(">\n");
+			rml.append(body);
+			rml.append("</body>\n</rml>\n");
+			return rml;
+		}
+
+		/// <summary>
+		/// Loads a document for the length of a benchmark and exposes it to Lua as bench_root.
+		/// </summary>
+		class ScopedDocument
+		{
+		public:
+			ScopedDocument(const Rml::String& path, Rml::String rml)
+			{
+				auto& headless = Headless::Get();
+				headless.Files.Set(path, std::move(rml));
+				m_document = headless.Context->LoadDocument(path);
+				if (m_document == nullptr)
+					return;
+
+				m_document->Show();
+				headless.Context->Update();
+				headless.Lua["bench_root"] = static_cast<Rml::Element*>(m_document);
+			}
+
+			~ScopedDocument()
+			{
+				auto& headless = Headless::Get();
+				headless.Lua["bench_root"] = sol::lua_nil;
+				if (m_document != nullptr)
+				{
+					m_document->Close();
+					headless.Context->Update();
+				}
+				headless.Lua.collect_garbage();
+			}
+
+			ScopedDocument(const ScopedDocument&) = delete;
+			ScopedDocument& operator=(const ScopedDocument&) = delete;
+
+			Rml::ElementDocument* Get() const { return m_document; }
+
+		private:
+			Rml::ElementDocument* m_document = nullptr;
+		};
+
+		/// <summary>
+		/// Calls a global Lua function, stopping the benchmark on errors.
+		/// </summary>
+		template <typename... Args>
+		bool call(benchmark::State& state, const char* name, Args&&... args)
+		{
+			sol::protected_function func = Headless::Get().Lua[name];
+			auto result = func(std::forward<Args>(args)...);
+			if (!result.valid())
+			{
+				sol::error err = result;
+				state.SkipWithError(err.what());
+				return false;
+			}
+			return true;
+		}
+	}
+
+	/// <summary>
+	/// Loads and unloads a document with an external script, an inline script and an inline listener per item.
+	/// </summary>
+	void DocumentLoad(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		headless.Files.Set("load.lua", "function bump() clicks = clicks + 1 end\n");
+		headless.Files.Set("load.rml", makeDocument("<script src=\"load.lua\"></script>\n<script>clicks = 0</script>\n", makeItems(state.range(0))));
+
+		for (auto _ : state)
+		{
+			auto document = headless.Context->LoadDocument("load.rml");
+			if (document == nullptr)
+			{
+				state.SkipWithError("load.rml failed to load");
+				break;
+			}
+			document->Close();
+			headless.Context->Update();
+		}
+
+		headless.Lua.collect_garbage();
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(DocumentLoad)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+	/// <summary>
+	/// Dispatches click events into a listener compiled from an onclick attribute.
+	/// </summary>
+	void DispatchInlineListener(benchmark::State& state)
+	{
+		ScopedDocument document{ "events.rml", makeDocument("<script>clicks = 0</script>\n", makeItems(1)) };
+		auto element = document.Get() != nullptr ? document.Get()->GetElementById("item1") : nullptr;
+		if (element == nullptr)
+		{
+			state.SkipWithError("events.rml failed to load");
+			return;
+		}
+
+		const Rml::Dictionary parameters;
+		for (auto _ : state)
+			element->DispatchEvent("click", parameters);
+
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(DispatchInlineListener);
+
+	/// <summary>
+	/// Dispatches click events into a Lua function added with Element:AddEventListener.
+	/// </summary>
+	void DispatchFunctionListener(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		ScopedDocument document{ "events.rml", makeDocument("<script>clicks = 0</script>\n", "<div id=\"target\"/>\n") };
+		auto element = document.Get() != nullptr ? document.Get()->GetElementById("target") : nullptr;
+		if (element == nullptr || !headless.Run("bench_clicks = 0\nbench_root:GetElementById('target'):AddEventListener('click', function(event) bench_clicks = bench_clicks + 1 end)"))
+		{
+			state.SkipWithError("events.rml failed to load");
+			return;
+		}
+
+		const Rml::Dictionary parameters;
+		for (auto _ : state)
+			element->DispatchEvent("click", parameters);
+
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(DispatchFunctionListener);
+
+	/// <summary>
+	/// Changes one value of a large array in a data model and updates the context.
+	/// </summary>
+	void DataModelRefresh(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		headless.Lua["bench_count"] = state.range(0);
+		if (!headless.Run(R"(
+			bench_items = {}
+			for i = 1, bench_count do
+				bench_items[i] = { name = 'item' .. i, value = i }
+			end
+			bench_model = context:OpenDataModel('bench', { items = bench_items })
+
+			function bench_touch(i)
+				local item = bench_items[i]
+				item.value = item.value + 1
+				bench_model.items = bench_items
+			end
+		)"))
+		{
+			state.SkipWithError("The data model failed to open");
+			return;
+		}
+
+		{
+			ScopedDocument document{ "model.rml", makeDocument("", "<div data-for=\"item : items\">{{item.name}}: {{item.value}}</div>\n", "data-model=\"bench\"") };
+			if (document.Get() == nullptr)
+			{
+				state.SkipWithError("model.rml failed to load");
+			}
+			else
+			{
+				int64_t index = 0;
+				for (auto _ : state)
+				{
+					if (!call(state, "bench_touch", index % state.range(0) + 1))
+						break;
+					headless.Context->Update();
+					++index;
+				}
+			}
+		}
+
+		headless.Run("bench_model:Close()\nbench_model = nil\nbench_items = nil\nbench_touch = nil");
+		headless.Lua.collect_garbage();
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(DataModelRefresh)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+	/// <summary>
+	/// Reads and writes element properties, styles and geometry from Lua.
+	/// </summary>
+	void ElementPropertyAccess(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		ScopedDocument document{ "properties.rml", makeDocument("", "<div id=\"target\" class=\"a b\" style=\"width: 50px; height: 20px;\"/>\n") };
+		if (document.Get() == nullptr || !headless.Run(R"(
+			function bench_properties(element, count)
+				local style = element.style
+				for i = 1, count do
+					style.width = '100px'
+					local width = style.width
+					style:SetNumber('height', i, 'px')
+					local height = style:GetNumber('height')
+					local id = element.id
+					local class_name = element.class_name
+					local left = element.offset_left
+					local client_width = element.client_width
+				end
+			end
+		)"))
+		{
+			state.SkipWithError("properties.rml failed to load");
+			return;
+		}
+
+		constexpr int Count = 100;
+		auto element = document.Get()->GetElementById("target");
+		for (auto _ : state)
+		{
+			if (!call(state, "bench_properties", element, Count))
+				break;
+		}
+
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(ElementPropertyAccess);
+
+	/// <summary>
+	/// Reads Element members through a plain Element, a form input and a document, to compare lookups on derived usertypes.
+	/// </summary>
+	void DerivedMemberLookup(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		ScopedDocument document{ "derived.rml", makeDocument("", "<div id=\"plain\"/>\n<input type=\"text\" id=\"input\"/>\n") };
+		if (document.Get() == nullptr || !headless.Run(R"(
+			bench_targets = {
+				bench_root:GetElementById('plain'),
+				Element.As.ElementFormControlInput(bench_root:GetElementById('input')),
+				Element.As.Document(bench_root),
+			}
+
+			function bench_members(target, count)
+				local element = bench_targets[target]
+				for i = 1, count do
+					local id = element.id
+					local tag_name = element.tag_name
+					local parent = element.parent_node
+					local has_id = element:HasAttribute('id')
+				end
+			end
+		)"))
+		{
+			state.SkipWithError("derived.rml failed to load");
+			return;
+		}
+
+		constexpr const char* Labels[] = { "Element", "ElementFormControlInput", "Document" };
+		state.SetLabel(Labels[state.range(0)]);
+
+		constexpr int Count = 100;
+		for (auto _ : state)
+		{
+			if (!call(state, "bench_members", state.range(0) + 1, Count))
+				break;
+		}
+
+		headless.Run("bench_targets = nil");
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(DerivedMemberLookup)->DenseRange(0, 2);
+
+	/// <summary>
+	/// Calls the Element bindings that take strings from Lua, and counts the C++ allocations each call makes.
+	/// </summary>
+	void HotStringCalls(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		ScopedDocument document{ "strings.rml", makeDocument("", "<div id=\"target\"/>\n") };
+		if (document.Get() == nullptr || !headless.Run(R"(
+			function bench_strings(element, count)
+				for i = 1, count do
+					element:SetAttribute('data-value', 'value')
+					local value = element:GetAttribute('data-value')
+					local has_value = element:HasAttribute('data-value')
+					element:SetClass('active', true)
+					local active = element:IsClassSet('active')
+				end
+			end
+		)"))
+		{
+			state.SkipWithError("strings.rml failed to load");
+			return;
+		}
+
+		constexpr int Count = 100;
+		constexpr int Calls = 5;
+		auto element = document.Get()->GetElementById("target");
+		const auto allocations = GetAllocationCount();
+		for (auto _ : state)
+		{
+			if (!call(state, "bench_strings", element, Count))
+				break;
+		}
+
+		const auto calls = state.iterations() * Count * Calls;
+		state.counters["allocs_per_call"] = calls > 0 ? static_cast<double>(GetAllocationCount() - allocations) / static_cast<double>(calls) : 0.0;
+		state.SetItemsProcessed(calls);
+	}
+	BENCHMARK(HotStringCalls);
+
+	/// <summary>
+	/// Runs QuerySelectorAll and QuerySelector from Lua over a number of items.
+	/// </summary>
+	void QuerySelector(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		ScopedDocument document{ "query.rml", makeDocument("<script>clicks = 0</script>\n", makeItems(state.range(0))) };
+		if (document.Get() == nullptr || !headless.Run(R"(
+			function bench_query(root)
+				local all = root:QuerySelectorAll('.item')
+				local last = root:QuerySelector('#item' .. #all)
+				return #all
+			end
+		)"))
+		{
+			state.SkipWithError("query.rml failed to load");
+			return;
+		}
+
+		for (auto _ : state)
+		{
+			if (!call(state, "bench_query", static_cast<Rml::Element*>(document.Get())))
+				break;
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(QuerySelector)->Arg(100)->Arg(1000);
+
+	/// <summary>
+	/// Converts Variants both ways: attributes set and read from Lua, and event parameters passed from a Lua table to a Lua listener.
+	/// </summary>
+	void VariantConversion(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		ScopedDocument document{ "variant.rml", makeDocument("", "<div id=\"target\"/>\n") };
+		if (document.Get() == nullptr || !headless.Run(R"(
+			bench_sum = 0
+			bench_root:GetElementById('target'):AddEventListener('custom', function(event)
+				local parameters = event.parameters
+				bench_sum = bench_sum + parameters.number
+			end)
+
+			function bench_variants(element, count)
+				for i = 1, count do
+					element:SetAttribute('data-value', 'value')
+					local value = element:GetAttribute('data-value')
+					element:DispatchEvent('custom', { number = i, text = 'text', flag = true })
+				end
+			end
+		)"))
+		{
+			state.SkipWithError("variant.rml failed to load");
+			return;
+		}
+
+		constexpr int Count = 100;
+		auto element = document.Get()->GetElementById("target");
+		for (auto _ : state)
+		{
+			if (!call(state, "bench_variants", element, Count))
+				break;
+		}
+
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(VariantConversion);
+
+	/// <summary>
+	/// Stores one type of value in an attribute with Element:SetAttributes and reads it back, to compare the Variant conversion of each type.
+	/// </summary>
+	void VariantTypeConversion(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		ScopedDocument document{ "variant.rml", makeDocument("", "<div id=\"target\"/>\n") };
+		if (document.Get() == nullptr || !headless.Run(R"(
+			bench_values = { 'value', 42, 0.5, true, Vector2f.new(1, 2), Colourb.new(1, 2, 3, 4), Colourf.new(0.1, 0.2, 0.3, 0.4) }
+
+			function bench_variant_type(element, index, count)
+				local attributes = { ['data-value'] = bench_values[index] }
+				for i = 1, count do
+					element:SetAttributes(attributes)
+					local value = element:GetAttribute('data-value')
+				end
+			end
+		)"))
+		{
+			state.SkipWithError("variant.rml failed to load");
+			return;
+		}
+
+		constexpr const char* Labels[] = { "string", "integer", "number", "boolean", "Vector2f", "Colourb", "Colourf" };
+		state.SetLabel(Labels[state.range(0)]);
+
+		constexpr int Count = 100;
+		auto element = document.Get()->GetElementById("target");
+		for (auto _ : state)
+		{
+			if (!call(state, "bench_variant_type", element, state.range(0) + 1, Count))
+				break;
+		}
+
+		headless.Run("bench_values = nil");
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(VariantTypeConversion)->DenseRange(0, 6);
+
+	/// <summary>
+	/// Moves a point with Vector2f userdata and with the unboxed RmlVec2 functions, and reports the Lua garbage each step makes.
+	/// </summary>
+	void VectorMathGC(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		if (!headless.Run(R"(
+			function bench_boxed(count)
+				local p = Vector2f.new(0, 0)
+				local v = Vector2f.new(1, 2)
+				for i = 1, count do
+					p = p + v * 0.5
+				end
+				return p.x
+			end
+
+			function bench_unboxed(count)
+				local x, y = 0, 0
+				for i = 1, count do
+					local sx, sy = RmlVec2.scale(1, 2, 0.5)
+					x, y = RmlVec2.add(x, y, sx, sy)
+				end
+				return x
+			end
+
+			-- Bytes allocated per step, with the collector stopped so nothing is freed meanwhile.
+			function bench_garbage(name, count)
+				collectgarbage('collect')
+				collectgarbage('stop')
+				local before = collectgarbage('count')
+				_G[name](count)
+				local after = collectgarbage('count')
+				collectgarbage('restart')
+				return (after - before) * 1024 / count
+			end
+		)"))
+		{
+			state.SkipWithError("The math functions failed to load");
+			return;
+		}
+
+		const char* name = state.range(0) == 0 ? "bench_boxed" : "bench_unboxed";
+		state.SetLabel(state.range(0) == 0 ? "Vector2f" : "RmlVec2");
+
+		constexpr int Count = 1000;
+		for (auto _ : state)
+		{
+			if (!call(state, name, Count))
+				break;
+		}
+
+		sol::protected_function garbage = headless.Lua["bench_garbage"];
+		auto bytes = garbage(name, Count);
+		if (bytes.valid())
+			state.counters["lua_bytes_per_step"] = bytes.get<double>();
+		state.SetItemsProcessed(state.iterations() * Count);
+	}
+	BENCHMARK(VectorMathGC)->Arg(0)->Arg(1);
+
+	/// <summary>
+	/// Calls the same element operations through sol and through the rmlui.ffi module.
+	/// The FFI run needs LuaJIT and a build with RMLSOLLUA_FFI.
+	/// </summary>
+	void ElementCallDispatch(benchmark::State& state)
+	{
+		const bool use_ffi = state.range(0) == 1;
+		state.SetLabel(use_ffi ? "ffi" : "sol");
+#ifndef RMLSOLLUA_FFI
+		if (use_ffi)
+		{
+			state.SkipWithError("Built without RMLSOLLUA_FFI");
+			return;
+		}
+#endif
+
+		auto& headless = Headless::Get();
+		ScopedDocument document{ "dispatch.rml", makeDocument("", "<div id=\"target\"/>\n") };
+		if (document.Get() == nullptr || !headless.Run(R"(
+			function bench_sol_calls(element, count)
+				for i = 1, count do
+					element:SetClass('active', i % 2 == 0)
+					local active = element:IsClassSet('active')
+					local has_id = element:HasAttribute('id')
+				end
+			end
+
+			function bench_ffi_calls(element, count)
+				local rmlffi = require('rmlui.ffi')
+				local p = element.pointer
+				for i = 1, count do
+					rmlffi.SetClass(p, 'active', i % 2 == 0)
+					local active = rmlffi.IsClassSet(p, 'active')
+					local has_id = rmlffi.HasAttribute(p, 'id')
+				end
+			end
+		)"))
+		{
+			state.SkipWithError("dispatch.rml failed to load");
+			return;
+		}
+
+		constexpr int Count = 100;
+		constexpr int Calls = 3;
+		auto element = document.Get()->GetElementById("target");
+		for (auto _ : state)
+		{
+			if (!call(state, use_ffi ? "bench_ffi_calls" : "bench_sol_calls", element, Count))
+				break;
+		}
+
+		state.SetItemsProcessed(state.iterations() * Count * Calls);
+	}
+	BENCHMARK(ElementCallDispatch)->Arg(0)->Arg(1);
+
+	/// <summary>
+	/// Calls overloaded bindings and their single signature names.
+	/// Run it from a checked and an RMLSOLLUA_UNCHECKED build to see what the safety checks cost per call.
+	/// </summary>
+	void OverloadDispatch(benchmark::State& state)
+	{
+		auto& headless = Headless::Get();
+		ScopedDocument document{ "overload.rml", makeDocument("", "<div id=\"target\" style=\"width: 100px; height: 100px;\"/>\n") };
+		if (document.Get() == nullptr || !headless.Run(R"(
+			function bench_overloaded(count)
+				local v = Vector2f.new(1, 2)
+				for i = 1, count do
+					local element = context:GetElementAtPoint(10, 10)
+					v = v * 1.0
+				end
+			end
+
+			function bench_single(count)
+				local v = Vector2f.new(1, 2)
+				for i = 1, count do
+					local element = context:GetElementAtXY(10, 10)
+					v = v:Scale(1.0)
+				end
+			end
+		)"))
+		{
+			state.SkipWithError("overload.rml failed to load");
+			return;
+		}
+
+		const bool single = state.range(0) == 1;
+		state.SetLabel(single ? "single" : "overloaded");
+
+		constexpr int Count = 100;
+		for (auto _ : state)
+		{
+			if (!call(state, single ? "bench_single" : "bench_overloaded", Count))
+				break;
+		}
+
+		state.SetItemsProcessed(state.iterations() * Count * 2);
+	}
+	BENCHMARK(OverloadDispatch)->Arg(0)->Arg(1);
+
+	/// <summary>
+	/// Creates a Lua state and registers the bindings up front, lazily, or lazily with the core usertypes touched.
+	/// The bare state is the baseline to subtract.
+	/// </summary>
+	void LazyStartup(benchmark::State& state)
+	{
+		static const char* const labels[] = { "state", "eager", "lazy", "lazy + Document" };
+		const auto mode = state.range(0);
+		state.SetLabel(labels[mode]);
+
+		for (auto _ : state)
+		{
+			sol::state lua;
+			lua.open_libraries(sol::lib::base, sol::lib::package, sol::lib::string, sol::lib::table, sol::lib::math);
+
+			if (mode == 1)
+				Rml::SolLua::RegisterLua(&lua);
+			else if (mode >= 2)
+				Rml::SolLua::RegisterLuaLazy(&lua);
+
+			if (mode == 3)
+			{
+				auto result = lua.safe_script("local document = Document", sol::script_pass_on_error);
+				if (!result.valid())
+				{
+					state.SkipWithError("touching Document failed");
+					break;
+				}
+			}
+
+			benchmark::DoNotOptimize(lua.lua_state());
+		}
+	}
+	BENCHMARK(LazyStartup)->DenseRange(0, 3);
+
+} // end namespace Rml::SolLua::Bench
@@ -0,0 +1,209 @@
+#include "Headless.h"
+
+#include <RmlSolLua/RmlSolLua.h>
+
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Log.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+
+namespace Rml::SolLua::Bench
+{
+
+	namespace
+	{
+		Rml::UniquePtr<Headless>& getHeadless()
+		{
+			static Rml::UniquePtr<Headless> headless;
+			return headless;
+		}
+
+		struct MemoryFile
+		{
+			const Rml::String* content;
+			size_t position = 0;
+		};
+	}
+
+	double HeadlessSystemInterface::GetElapsedTime()
+	{
+		if (m_time >= 0.0)
+			return m_time;
+
+		static const auto start = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	bool HeadlessSystemInterface::LogMessage(Rml::Log::Type type, const Rml::String& message)
+	{
+		if (type <= Rml::Log::LT_ERROR)
+			std::fprintf(stderr, "%s\n", message.c_str());
+		return true;
+	}
+
+	//-----------------------------------------------------
+
+#if RmlUi_VERSION_MAJOR >= 6
+	Rml::CompiledGeometryHandle HeadlessRenderInterface::CompileGeometry(Rml::Span<const Rml::Vertex>, Rml::Span<const int>)
+	{
+		// Zero means failure, so hand out a dummy handle.
+		return 1;
+	}
+
+	void HeadlessRenderInterface::RenderGeometry(Rml::CompiledGeometryHandle, Rml::Vector2f, Rml::TextureHandle) {}
+
+	void HeadlessRenderInterface::ReleaseGeometry(Rml::CompiledGeometryHandle) {}
+
+	Rml::TextureHandle HeadlessRenderInterface::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String&)
+	{
+		texture_dimensions = { 1, 1 };
+		return 1;
+	}
+
+	Rml::TextureHandle HeadlessRenderInterface::GenerateTexture(Rml::Span<const Rml::byte>, Rml::Vector2i)
+	{
+		return 1;
+	}
+
+	void HeadlessRenderInterface::ReleaseTexture(Rml::TextureHandle) {}
+
+	void HeadlessRenderInterface::EnableScissorRegion(bool) {}
+
+	void HeadlessRenderInterface::SetScissorRegion(Rml::Rectanglei) {}
+#else
+	void HeadlessRenderInterface::RenderGeometry(Rml::Vertex*, int, int*, int, Rml::TextureHandle, const Rml::Vector2f&) {}
+
+	void HeadlessRenderInterface::EnableScissorRegion(bool) {}
+
+	void HeadlessRenderInterface::SetScissorRegion(int, int, int, int) {}
+#endif
+
+	//-----------------------------------------------------
+
+	void MemoryFileInterface::Set(const Rml::String& path, Rml::String content)
+	{
+		m_files[path] = std::move(content);
+	}
+
+	Rml::FileHandle MemoryFileInterface::Open(const Rml::String& path)
+	{
+		auto iter = m_files.find(path);
+		if (iter == m_files.end())
+		{
+			std::ifstream stream{ path, std::ios::binary };
+			if (!stream)
+				return 0;
+
+			Rml::String content{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+			iter = m_files.emplace(path, std::move(content)).first;
+		}
+
+		return reinterpret_cast<Rml::FileHandle>(new MemoryFile{ &iter->second });
+	}
+
+	void MemoryFileInterface::Close(Rml::FileHandle file)
+	{
+		delete reinterpret_cast<MemoryFile*>(file);
+	}
+
+	size_t MemoryFileInterface::Read(void* buffer, size_t size, Rml::FileHandle file)
+	{
+		auto* f = reinterpret_cast<MemoryFile*>(file);
+		size = std::min(size, f->content->size() - f->position);
+		std::memcpy(buffer, f->content->data() + f->position, size);
+		f->position += size;
+		return size;
+	}
+
+	bool MemoryFileInterface::Seek(Rml::FileHandle file, long offset, int origin)
+	{
+		auto* f = reinterpret_cast<MemoryFile*>(file);
+
+		long base = 0;
+		if (origin == SEEK_CUR)
+			base = static_cast<long>(f->position);
+		else if (origin == SEEK_END)
+			base = static_cast<long>(f->content->size());
+
+		const long position = base + offset;
+		if (position < 0 || position > static_cast<long>(f->content->size()))
+			return false;
+
+		f->position = static_cast<size_t>(position);
+		return true;
+	}
+
+	size_t MemoryFileInterface::Tell(Rml::FileHandle file)
+	{
+		return reinterpret_cast<MemoryFile*>(file)->position;
+	}
+
+	size_t MemoryFileInterface::Length(Rml::FileHandle file)
+	{
+		return reinterpret_cast<MemoryFile*>(file)->content->size();
+	}
+
+	//-----------------------------------------------------
+
+	bool Headless::Initialise(bool lazy)
+	{
+		auto& headless = getHeadless();
+		headless = Rml::MakeUnique<Headless>();
+		// package before RmlSolLua, for require(); ffi and jit only load under LuaJIT.
+		headless->Lua.open_libraries(sol::lib::base, sol::lib::package, sol::lib::string, sol::lib::table, sol::lib::math, sol::lib::ffi, sol::lib::jit);
+
+		Rml::SetSystemInterface(&headless->m_system);
+		Rml::SetRenderInterface(&headless->m_render);
+		Rml::SetFileInterface(&headless->Files);
+		if (!Rml::Initialise())
+			return false;
+
+		if (lazy)
+			Rml::SolLua::InitialiseLazy(&headless->Lua);
+		else
+			Rml::SolLua::Initialise(&headless->Lua);
+
+		headless->Context = Rml::CreateContext("bench", Rml::Vector2i{ 1280, 720 });
+		if (headless->Context == nullptr)
+			return false;
+
+		headless->Lua["context"] = headless->Context;
+		return true;
+	}
+
+	void Headless::Shutdown()
+	{
+		auto& headless = getHeadless();
+		if (!headless)
+			return;
+
+		headless->Lua.collect_garbage();
+		Rml::Shutdown();
+		headless.reset();
+	}
+
+	Headless& Headless::Get()
+	{
+		return *getHeadless();
+	}
+
+	bool Headless::Run(const Rml::String& code)
+	{
+		auto result = Lua.safe_script(code, sol::script_pass_on_error);
+		if (!result.valid())
+		{
+			sol::error err = result;
+			Rml::Log::Message(Rml::Log::LT_ERROR, "[LUA][ERROR] %s", err.what());
+			return false;
+		}
+		return true;
+	}
+
+} // end namespace Rml::SolLua::Bench
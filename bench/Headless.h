@@ -0,0 +1,124 @@
+#pragma once
+
+#include <RmlUi/Core/FileInterface.h>
+#include <RmlUi/Core/RenderInterface.h>
+#include <RmlUi/Core/SystemInterface.h>
+#include <RmlUi/Core/Types.h>
+
+#include <sol/sol.hpp>
+
+
+namespace Rml
+{
+	class Context;
+}
+
+namespace Rml::SolLua::Bench
+{
+	/// <summary>
+	/// Keeps time and drops every log message below errors.  Documents have no fonts, so text logs a warning per element.
+	/// </summary>
+	class HeadlessSystemInterface : public Rml::SystemInterface
+	{
+	public:
+		double GetElapsedTime() override;
+		bool LogMessage(Rml::Log::Type type, const Rml::String& message) override;
+
+		/// <summary>
+		/// Stops the clock at a time, so replays see the recorded time.
+		/// </summary>
+		void SetTime(double time) { m_time = time; }
+
+	private:
+		double m_time = -1.0;
+	};
+
+	/// <summary>
+	/// Render interface that draws nothing.  The benchmarks never render, so only the required functions are implemented.
+	/// </summary>
+	class HeadlessRenderInterface : public Rml::RenderInterface
+	{
+	public:
+#if RmlUi_VERSION_MAJOR >= 6
+		Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
+		void RenderGeometry(Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation, Rml::TextureHandle texture) override;
+		void ReleaseGeometry(Rml::CompiledGeometryHandle geometry) override;
+		Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+		Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions) override;
+		void ReleaseTexture(Rml::TextureHandle texture) override;
+		void EnableScissorRegion(bool enable) override;
+		void SetScissorRegion(Rml::Rectanglei region) override;
+#else
+		void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture, const Rml::Vector2f& translation) override;
+		void EnableScissorRegion(bool enable) override;
+		void SetScissorRegion(int x, int y, int width, int height) override;
+#endif
+	};
+
+	/// <summary>
+	/// File interface over in-memory files, so loading measures parsing and scripts instead of the disk.
+	/// Files that weren't set are read from the disk once and kept in memory.
+	/// </summary>
+	class MemoryFileInterface : public Rml::FileInterface
+	{
+	public:
+		/// <summary>
+		/// Adds or replaces a file.
+		/// </summary>
+		void Set(const Rml::String& path, Rml::String content);
+
+		Rml::FileHandle Open(const Rml::String& path) override;
+		void Close(Rml::FileHandle file) override;
+		size_t Read(void* buffer, size_t size, Rml::FileHandle file) override;
+		bool Seek(Rml::FileHandle file, long offset, int origin) override;
+		size_t Tell(Rml::FileHandle file) override;
+		size_t Length(Rml::FileHandle file) override;
+
+	private:
+		Rml::UnorderedMap<Rml::String, Rml::String> m_files;
+	};
+
+	/// <summary>
+	/// RmlUi and RmlSolLua initialised without a window, with one context shared by every benchmark.
+	/// </summary>
+	class Headless
+	{
+	public:
+		/// <summary>
+		/// Initialises RmlUi and RmlSolLua.
+		/// </summary>
+		/// <param name="lazy">Registers the bindings lazily, with InitialiseLazy.</param>
+		/// <returns>False if RmlUi failed to initialise.</returns>
+		static bool Initialise(bool lazy = false);
+
+		/// <summary>
+		/// Shuts down RmlUi, then closes the Lua state.
+		/// </summary>
+		static void Shutdown();
+
+		/// <summary>
+		/// Gets the environment.  Only valid between Initialise and Shutdown.
+		/// </summary>
+		static Headless& Get();
+
+		/// <summary>
+		/// Stops the clock RmlUi sees at a time.
+		/// </summary>
+		void SetTime(double time) { m_system.SetTime(time); }
+
+		/// <summary>
+		/// Runs a chunk in the global environment.
+		/// </summary>
+		/// <returns>False, after logging the error, if the chunk failed.</returns>
+		bool Run(const Rml::String& code);
+
+		sol::state Lua;
+		MemoryFileInterface Files;
+		Rml::Context* Context = nullptr;
+
+	private:
+		HeadlessSystemInterface m_system;
+		HeadlessRenderInterface m_render;
+	};
+
+} // end namespace Rml::SolLua::Bench
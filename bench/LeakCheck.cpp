@@ -0,0 +1,198 @@
+#include "Headless.h"
+
+#include <RmlSolLua/RmlSolLua.h>
+
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/ElementDocument.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace
+{
+	constexpr const char* Usage =
+		"Usage: RmlSolLua_leakcheck [options]\n"
+		"  --cycles <n>         Documents to open and close.  Default 10000.\n"
+		"  --tolerance-kb <kb>  Allowed growth of the Lua heap.  Default 64.\n"
+		"  --lazy               Registers the bindings lazily.\n"
+		"Exits with 2 when live objects or the Lua heap grew.\n";
+
+	constexpr int WarmupCycles = 100;
+
+	// An external script, an inline script, inline listeners and a data model bound by the body.
+	constexpr const char* LeakDocument = R"(<rml>
+<head>
+<script src="leak.lua"></script>
+<script>
+	local count = 0
+	function OnLeakClick() count = count + 1 end
+</script>
+</head>
+<body data-model="leak">
+<div id="value" onclick="OnLeakClick()">{{value}}</div>
+<div onmouseover="OnLeakClick()">{{value}}</div>
+</body>
+</rml>
+)";
+
+	// Loaded before the cycles, so Element.As is first read after the instancers registered the core bindings.
+	constexpr const char* ConvertDocument = R"(<rml>
+<head></head>
+<body>
+<input type="text" id="input" value="text"/>
+</body>
+</rml>
+)";
+
+	/// <summary>
+	/// Checks that Element.As converts to a form control once a document has loaded.
+	/// </summary>
+	bool checkConvert(Rml::SolLua::Bench::Headless& headless)
+	{
+		headless.Files.Set("convert.rml", ConvertDocument);
+		auto document = headless.Context->LoadDocument("convert.rml");
+		if (document == nullptr)
+			return false;
+
+		headless.Lua["convert_document"] = static_cast<Rml::Element*>(document);
+		const bool converted = headless.Run(R"(
+			local input = Element.As.ElementFormControlInput(convert_document:GetElementById('input'))
+			assert(input ~= nil and input.value == 'text', 'Element.As.ElementFormControlInput failed')
+		)");
+		headless.Lua["convert_document"] = sol::lua_nil;
+
+		document->Close();
+		headless.Context->Update();
+		return converted;
+	}
+
+	struct Snapshot
+	{
+		Rml::SolLua::RuntimeStats Stats;
+		std::size_t LuaBytes = 0;
+	};
+
+	Snapshot takeSnapshot(Rml::SolLua::Bench::Headless& headless)
+	{
+		headless.Lua.collect_garbage();
+		headless.Lua.collect_garbage();
+
+		Snapshot snapshot;
+		snapshot.Stats = Rml::SolLua::GetRuntimeStats(&headless.Lua);
+		snapshot.LuaBytes = headless.Lua.memory_used();
+		return snapshot;
+	}
+
+	/// <summary>
+	/// Opens the data model, loads, shows and updates the document, then closes both.
+	/// </summary>
+	bool cycle(Rml::SolLua::Bench::Headless& headless)
+	{
+		if (!headless.Run("leak_model = context:OpenDataModel('leak', { value = 1 })"))
+			return false;
+
+		auto document = headless.Context->LoadDocument("leak.rml");
+		if (document == nullptr)
+			return false;
+
+		document->Show();
+		headless.Context->Update();
+		if (auto element = document->GetElementById("value"); element != nullptr)
+			element->Click();
+
+		document->Close();
+		headless.Context->Update();
+		return headless.Run("leak_model:Close() leak_model = nil");
+	}
+
+	int check(const char* name, int64_t before, int64_t after)
+	{
+		std::printf("%-18s %10lld %10lld\n", name, static_cast<long long>(before), static_cast<long long>(after));
+		return after > before ? 1 : 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace Rml::SolLua::Bench;
+
+	int cycles = 10000;
+	double tolerance_kb = 64.0;
+	bool lazy = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool has_value = i + 1 < argc;
+		if (has_value && std::strcmp(argv[i], "--cycles") == 0)
+			cycles = std::atoi(argv[++i]);
+		else if (has_value && std::strcmp(argv[i], "--tolerance-kb") == 0)
+			tolerance_kb = std::atof(argv[++i]);
+		else if (std::strcmp(argv[i], "--lazy") == 0)
+			lazy = true;
+		else
+		{
+			std::fputs(Usage, stderr);
+			return 1;
+		}
+	}
+
+	if (!Headless::Initialise(lazy))
+		return 1;
+
+	auto& headless = Headless::Get();
+	headless.Files.Set("leak.lua", "function OnLeakLoad() end\n");
+	headless.Files.Set("leak.rml", LeakDocument);
+
+	int result = 0;
+	if (!checkConvert(headless))
+	{
+		std::fprintf(stderr, "Element.As doesn't convert elements of a loaded document.\n");
+		result = 1;
+	}
+
+	// Caches, interned strings and the first allocator slots fill up during the warm-up.
+	for (int i = 0; i < WarmupCycles && result == 0; ++i)
+	{
+		if (!cycle(headless))
+			result = 1;
+	}
+
+	const auto before = result == 0 ? takeSnapshot(headless) : Snapshot();
+	for (int i = 0; i < cycles && result == 0; ++i)
+	{
+		if (!cycle(headless))
+		{
+			std::fprintf(stderr, "Cycle %d failed.\n", i);
+			result = 1;
+		}
+	}
+
+	if (result == 0)
+	{
+		const auto after = takeSnapshot(headless);
+
+		std::printf("%d cycles\n%-18s %10s %10s\n", cycles, "", "before", "after");
+		int leaks = 0;
+		leaks += check("listeners", before.Stats.Listeners, after.Stats.Listeners);
+		leaks += check("compiled listeners", before.Stats.CompiledListeners, after.Stats.CompiledListeners);
+		leaks += check("documents", before.Stats.Documents, after.Stats.Documents);
+		leaks += check("data models", before.Stats.DataModels, after.Stats.DataModels);
+		leaks += check("data model values", before.Stats.DataModelObjects, after.Stats.DataModelObjects);
+
+		const double growth_kb = (static_cast<double>(after.LuaBytes) - static_cast<double>(before.LuaBytes)) / 1024.0;
+		std::printf("%-18s %10zu %10zu (%+.1fKB)\n", "lua bytes", before.LuaBytes, after.LuaBytes, growth_kb);
+		if (growth_kb > tolerance_kb)
+			++leaks;
+
+		if (leaks != 0)
+		{
+			std::printf("%d counters grew.\n", leaks);
+			result = 2;
+		}
+	}
+
+	Headless::Shutdown();
+	return result;
+}
@@ -0,0 +1,191 @@
+#include "Headless.h"
+
+#include <RmlSolLua/RmlSolLua.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+
+namespace
+{
+	constexpr const char* Usage =
+		"Usage: RmlSolLua_replay <recording> [options]\n"
+		"  --script <file>          Lua file run before the replay, to create contexts and load documents.  Repeatable.\n"
+		"  --save-baseline <file>   Writes the per-frame timings as a baseline.\n"
+		"  --baseline <file>        Compares the Lua time of each frame with a baseline.\n"
+		"  --tolerance <ratio>      Allowed slowdown of a frame before it counts as a regression.  Default 0.25.\n"
+		"  --min-ms <ms>            Differences below this are noise.  Default 0.1.\n"
+		"Exits with 2 when a frame regressed.\n";
+
+	bool readFile(const char* path, Rml::String& out)
+	{
+		std::ifstream stream{ path, std::ios::binary };
+		if (!stream)
+		{
+			std::fprintf(stderr, "Can't read %s\n", path);
+			return false;
+		}
+		out.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	double percentile(Rml::Vector<double> values, double p)
+	{
+		if (values.empty())
+			return 0.0;
+		std::sort(values.begin(), values.end());
+		return values[static_cast<std::size_t>(p * static_cast<double>(values.size() - 1))];
+	}
+
+	Rml::String writeBaseline(const Rml::Vector<Rml::SolLua::ReplayFrame>& frames)
+	{
+		Rml::String out{ "# frame time frame_ms lua_ms\n" };
+		char line[128];
+		for (std::size_t i = 0; i < frames.size(); ++i)
+		{
+			std::snprintf(line, sizeof(line), "%zu %.6f %.4f %.4f\n", i, frames[i].Time, frames[i].FrameMs, frames[i].LuaMs);
+			out.append(line);
+		}
+		return out;
+	}
+
+	Rml::Vector<Rml::SolLua::ReplayFrame> readBaseline(const Rml::String& text)
+	{
+		Rml::Vector<Rml::SolLua::ReplayFrame> frames;
+		std::istringstream stream{ text };
+		Rml::String line;
+		while (std::getline(stream, line))
+		{
+			if (line.empty() || line[0] == '#')
+				continue;
+
+			std::size_t index = 0;
+			Rml::SolLua::ReplayFrame frame;
+			if (std::sscanf(line.c_str(), "%zu %lf %lf %lf", &index, &frame.Time, &frame.FrameMs, &frame.LuaMs) == 4)
+				frames.push_back(frame);
+		}
+		return frames;
+	}
+
+	/// <summary>
+	/// Compares the Lua time of each frame.  Frame time includes layout, which depends on fonts and the machine, so it is only reported.
+	/// </summary>
+	/// <returns>The number of regressed frames.</returns>
+	int compare(const Rml::Vector<Rml::SolLua::ReplayFrame>& baseline, const Rml::Vector<Rml::SolLua::ReplayFrame>& frames, double tolerance, double min_ms)
+	{
+		if (baseline.size() != frames.size())
+			std::printf("Baseline has %zu frames, replay has %zu.  Comparing the common frames.\n", baseline.size(), frames.size());
+
+		int regressions = 0;
+		const auto count = std::min(baseline.size(), frames.size());
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const double before = baseline[i].LuaMs;
+			const double after = frames[i].LuaMs;
+			if (after - before > min_ms && after > before * (1.0 + tolerance))
+			{
+				std::printf("Frame %zu at %.3fs: Lua %.3fms, baseline %.3fms (+%.0f%%)\n", i, frames[i].Time, after, before, before > 0.0 ? (after / before - 1.0) * 100.0 : 100.0);
+				++regressions;
+			}
+		}
+		return regressions;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace Rml::SolLua::Bench;
+
+	if (argc < 2)
+	{
+		std::fputs(Usage, stderr);
+		return 1;
+	}
+
+	const char* recording_path = argv[1];
+	Rml::Vector<const char*> scripts;
+	const char* save_baseline = nullptr;
+	const char* baseline_path = nullptr;
+	double tolerance = 0.25;
+	double min_ms = 0.1;
+
+	for (int i = 2; i < argc; ++i)
+	{
+		const bool has_value = i + 1 < argc;
+		if (has_value && std::strcmp(argv[i], "--script") == 0)
+			scripts.push_back(argv[++i]);
+		else if (has_value && std::strcmp(argv[i], "--save-baseline") == 0)
+			save_baseline = argv[++i];
+		else if (has_value && std::strcmp(argv[i], "--baseline") == 0)
+			baseline_path = argv[++i];
+		else if (has_value && std::strcmp(argv[i], "--tolerance") == 0)
+			tolerance = std::atof(argv[++i]);
+		else if (has_value && std::strcmp(argv[i], "--min-ms") == 0)
+			min_ms = std::atof(argv[++i]);
+		else
+		{
+			std::fputs(Usage, stderr);
+			return 1;
+		}
+	}
+
+	Rml::String recording;
+	if (!readFile(recording_path, recording))
+		return 1;
+
+	Rml::String baseline;
+	if (baseline_path != nullptr && !readFile(baseline_path, baseline))
+		return 1;
+
+	if (!Headless::Initialise())
+		return 1;
+
+	int result = 0;
+	auto& headless = Headless::Get();
+	for (auto script : scripts)
+	{
+		Rml::String code;
+		if (!readFile(script, code) || !headless.Run(code))
+		{
+			result = 1;
+			break;
+		}
+	}
+
+	if (result == 0)
+	{
+		const auto frames = Rml::SolLua::Replay(recording, [&headless](double time) { headless.SetTime(time); });
+
+		Rml::Vector<double> lua_ms;
+		double total_ms = 0.0;
+		for (const auto& frame : frames)
+		{
+			lua_ms.push_back(frame.LuaMs);
+			total_ms += frame.LuaMs;
+		}
+		std::printf("%zu frames, Lua %.3fms total, p50 %.3fms, p95 %.3fms, max %.3fms\n", frames.size(), total_ms,
+			percentile(lua_ms, 0.5), percentile(lua_ms, 0.95), percentile(lua_ms, 1.0));
+
+		if (save_baseline != nullptr)
+		{
+			std::ofstream stream{ save_baseline, std::ios::binary };
+			stream << writeBaseline(frames);
+		}
+
+		if (baseline_path != nullptr)
+		{
+			const int regressions = compare(readBaseline(baseline), frames, tolerance, min_ms);
+			std::printf("%d frames regressed beyond %.0f%%.\n", regressions, tolerance * 100.0);
+			if (regressions != 0)
+				result = 2;
+		}
+	}
+
+	Headless::Shutdown();
+	return result;
+}
@@ -0,0 +1,19 @@
+#include "Headless.h"
+
+#include <benchmark/benchmark.h>
+
+
+int main(int argc, char** argv)
+{
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	if (!Rml::SolLua::Bench::Headless::Initialise())
+		return 1;
+
+	benchmark::RunSpecifiedBenchmarks();
+
+	Rml::SolLua::Bench::Headless::Shutdown();
+	return 0;
+}
@@ -2,6 +2,9 @@
 
 #include <RmlUi/Core.h>
 
+#include <cstddef>
+#include <cstdint>
+
 #ifdef RMLUILUA_API
     #undef RMLUILUA_API
 #endif
@@ -28,6 +31,130 @@ namespace sol
 
 namespace Rml::SolLua
 {
+    /// <summary>
+    /// Runtime counters of the library, for telemetry.
+    /// </summary>
+    struct RuntimeStats
+    {
+        /// <summary>
+        /// Calls from C++ into Lua, by entry point.
+        /// </summary>
+        struct Calls
+        {
+            uint64_t Scripts = 0;
+            uint64_t Listeners = 0;
+            uint64_t DataEvents = 0;
+            uint64_t DataModel = 0;
+        };
+
+        int64_t Listeners = 0;
+        // Live listeners compiled from inline code that still hold their function.
+        int64_t CompiledListeners = 0;
+        int64_t Documents = 0;
+        int64_t DataModels = 0;
+        int64_t DataModelObjects = 0;
+        int64_t LuaHeapKB = 0;
+
+        Calls Frame;
+        Calls LastFrame;
+        Calls Total;
+    };
+
+    /// <summary>
+    /// Counts of the Lua errors raised at one place.
+    /// </summary>
+    struct ErrorStats
+    {
+        /// <summary>
+        /// "chunk:line" of the error, or the first line of its message when it has no position.
+        /// </summary>
+        Rml::String Key;
+        Rml::String FirstMessage;
+        Rml::String LastMessage;
+        uint64_t Count = 0;
+
+        /// <summary>
+        /// Errors counted but not logged.
+        /// </summary>
+        uint64_t Suppressed = 0;
+    };
+
+    /// <summary>
+    /// Receives every Lua error caught by the library, in place of the log.
+    /// The first error from a place has a traceback and a count of 1.
+    /// </summary>
+    using ErrorCallback = Rml::Function<void(const Rml::String& key, const Rml::String& message, uint64_t count)>;
+
+    /// <summary>
+    /// Counters of the compiled chunk cache used by require() and external document scripts.
+    /// </summary>
+    struct ChunkCacheStats
+    {
+        uint64_t Hits = 0;
+        uint64_t Misses = 0;
+        std::size_t Entries = 0;
+        std::size_t Bytes = 0;
+    };
+
+    /// <summary>
+    /// Timings of one replayed update.
+    /// </summary>
+    struct ReplayFrame
+    {
+        /// <summary>
+        /// Elapsed time RmlUi saw when the update was recorded, in seconds.
+        /// </summary>
+        double Time = 0.0;
+
+        /// <summary>
+        /// Time spent replaying the input and update of the frame, in milliseconds.
+        /// </summary>
+        double FrameMs = 0.0;
+
+        /// <summary>
+        /// Part of FrameMs spent running Lua, in milliseconds.
+        /// </summary>
+        double LuaMs = 0.0;
+    };
+
+    /// <summary>
+    /// Latency of one Lua entry point, such as an event listener or a document script.
+    /// </summary>
+    struct LatencyStats
+    {
+        static constexpr int BucketCount = 16;
+
+        /// <summary>
+        /// Upper bound of a histogram bucket.  Bucket i holds calls shorter than 2^(i+1) microseconds; the last bucket holds everything slower.
+        /// </summary>
+        static double GetBucketUpperBoundMs(int bucket) { return static_cast<double>(1u << (bucket + 1)) / 1000.0; }
+
+        /// <summary>
+        /// Estimates a percentile from the histogram.
+        /// </summary>
+        /// <param name="percentile">Between 0 and 1.</param>
+        /// <returns>The upper bound of the bucket holding the percentile, or the maximum for the last bucket.</returns>
+        double GetPercentileMs(double percentile) const
+        {
+            const auto target = static_cast<uint64_t>(percentile * static_cast<double>(Count));
+            uint64_t seen = 0;
+            for (int i = 0; i < BucketCount - 1; ++i)
+            {
+                seen += Buckets[i];
+                if (seen > target)
+                    return GetBucketUpperBoundMs(i);
+            }
+            return MaxMs;
+        }
+
+        Rml::String Label;
+        uint64_t Count = 0;
+        double TotalMs = 0.0;
+        double MaxMs = 0.0;
+        uint64_t Slow = 0;
+        uint32_t Buckets[BucketCount] = {};
+    };
+
     /// <summary>
     /// Initializes RmlSolLua using the supplied Lua state.
     /// </summary>
@@ -42,6 +169,21 @@ namespace Rml::SolLua
     /// <param name="lua_environment_identifier">The Lua variable name that is set to the document's id.</param>
     RMLUILUA_API void Initialise(sol::state_view* state, const Rml::String& lua_environment_identifier);
 
+    /// <summary>
+    /// Initializes RmlSolLua using the supplied Lua state, registering the bindings lazily.
+    /// See RegisterLuaLazy.
+    /// </summary>
+    /// <param name="state">The Lua state to initialize into.</param>
+    RMLUILUA_API void InitialiseLazy(sol::state_view* state);
+
+    /// <summary>
+    /// Initializes RmlSolLua using the supplied Lua state, registering the bindings lazily.
+    /// Sets the Lua variable specified by lua_environment_identifier to the document's id when running Lua code.
+    /// </summary>
+    /// <param name="state">The Lua state to initialize into.</param>
+    /// <param name="lua_environment_identifier">The Lua variable name that is set to the document's id.</param>
+    RMLUILUA_API void InitialiseLazy(sol::state_view* state, const Rml::String& lua_environment_identifier);
+
     /// <summary>
     /// Initializes RmlSolLua using the supplied Lua state.
     /// </summary>
@@ -58,8 +200,224 @@ namespace Rml::SolLua
 
     /// <summary>
     /// Registers RmlSolLua into the specified Lua state.
+    /// Unless the host set one, also sets the default message handler of sol protected functions, which adds tracebacks to new errors.
+    /// If the package library is open, require() also searches the RmlUi file interface (see SetModulePaths).
     /// </summary>
     /// <param name="state">The Lua state to register into.</param>
     RMLUILUA_API void RegisterLua(sol::state_view* state);
 
+    /// <summary>
+    /// Registers RmlSolLua into the specified Lua state on demand.
+    /// Each group of bindings is installed the first time one of its global names is read.
+    /// The element, document, context and event usertypes are also installed before the first document or listener is created.
+    /// Call RegisterLua before pushing RmlUi objects into the state from C++.
+    /// </summary>
+    /// <param name="state">The Lua state to register into.</param>
+    RMLUILUA_API void RegisterLuaLazy(sol::state_view* state);
+
+    /// <summary>
+    /// Installs an allocator on the Lua state that pools small blocks and tracks memory per document.
+    /// The stats are returned by rmlui.MemoryStats().  Install it before Initialise so the bindings are tracked too.
+    /// </summary>
+    /// <param name="state">The Lua state to install into.</param>
+    RMLUILUA_API void InstallTrackedAllocator(sol::state_view* state);
+
+    /// <summary>
+    /// Stops automatic garbage collection and collects incrementally once per frame instead, within a time budget.
+    /// Calling it again changes the budget.  The stats are returned by rmlui.GCStats().
+    /// </summary>
+    /// <param name="state">The Lua state.</param>
+    /// <param name="budget_ms">Time to spend collecting each frame, in milliseconds.</param>
+    RMLUILUA_API void EnableManagedGC(sol::state_view* state, double budget_ms = 1.0);
+
+    /// <summary>
+    /// Restores automatic garbage collection.
+    /// </summary>
+    /// <param name="state">The Lua state.</param>
+    RMLUILUA_API void DisableManagedGC(sol::state_view* state);
+
+    /// <summary>
+    /// Runs the frame's collection step when managed collection is enabled.
+    /// Call it once per frame after updating the contexts.  Context:Update() called from Lua does this already, once per frame when several contexts are updated.
+    /// </summary>
+    /// <param name="state">The Lua state.</param>
+    RMLUILUA_API void StepManagedGC(sol::state_view* state);
+
+    /// <summary>
+    /// Turns latency recording of Lua entry points on or off.
+    /// Each event listener is labelled "[context][document] tag#id.class" and has its own stats, even when listeners share a label.
+    /// Once a listener is destroyed, its stats are merged into one entry per label.
+    /// Calls slower than the threshold are logged as warnings, at most ten per second.
+    /// The stats are returned by GetLatencyStats() and rmlui.LatencyStats().
+    /// </summary>
+    /// <param name="enabled">Whether to record.</param>
+    /// <param name="slow_threshold_ms">Calls taking longer than this are logged as warnings.  0 disables the log.</param>
+    RMLUILUA_API void EnableLatencyTracking(bool enabled, double slow_threshold_ms = 8.0);
+
+    /// <summary>
+    /// Gets the recorded latency of every Lua entry point, slowest total first.
+    /// </summary>
+    /// <returns>The stats.</returns>
+    RMLUILUA_API Rml::Vector<LatencyStats> GetLatencyStats();
+
+    /// <summary>
+    /// Clears the recorded latency.
+    /// </summary>
+    RMLUILUA_API void ResetLatencyStats();
+
+    /// <summary>
+    /// Starts recording every transition from C++ into Lua as a trace span, discarding previous spans.
+    /// Spans go into a fixed size lock-free ring buffer, so recording can stay on and be dumped when needed.
+    /// Call it while no Lua code is running.
+    /// </summary>
+    /// <param name="capacity">Number of most recent spans kept.</param>
+    RMLUILUA_API void EnableTracing(std::size_t capacity = 16384);
+
+    /// <summary>
+    /// Stops recording trace spans.  The recorded spans can still be dumped.
+    /// </summary>
+    RMLUILUA_API void DisableTracing();
+
+    /// <summary>
+    /// Returns the recorded spans as Chrome trace event JSON, readable by chrome://tracing and Perfetto.
+    /// Also available from Lua as rmlui.DumpTrace().
+    /// </summary>
+    /// <returns>The JSON document.</returns>
+    RMLUILUA_API Rml::String DumpTrace();
+
+    /// <summary>
+    /// Starts sampling the Lua call stack of a state, discarding previous samples.
+    /// Also available from Lua as rmlui.StartProfiler(hz).
+    /// </summary>
+    /// <param name="state">The Lua state to sample.</param>
+    /// <param name="hz">Samples per second.</param>
+    RMLUILUA_API void StartProfiler(sol::state_view* state, int hz = 1000);
+
+    /// <summary>
+    /// Stops the profiler.  Also available from Lua as rmlui.StopProfiler().
+    /// Each stack starts with the document that was running, as [url], or the chunk name outside documents.
+    /// </summary>
+    /// <returns>The samples as collapsed stacks, one "root;caller;callee count" line per stack, for flamegraph tools.</returns>
+    RMLUILUA_API Rml::String StopProfiler();
+
+    /// <summary>
+    /// Gets the runtime counters.  Also available from Lua as rmlui.Stats().
+    /// Counters are kept per thread; call it from the thread that runs Lua.
+    /// </summary>
+    /// <param name="state">The Lua state to read the heap size from, or nullptr.</param>
+    /// <returns>The counters.</returns>
+    RMLUILUA_API RuntimeStats GetRuntimeStats(sol::state_view* state);
+
+    /// <summary>
+    /// Ends the frame for the per-frame call counters: the current counts become LastFrame and Frame starts from zero.
+    /// Also available from Lua as rmlui.ResetFrameStats().
+    /// </summary>
+    RMLUILUA_API void ResetFrameStats();
+
+    /// <summary>
+    /// Starts recording the input and Update calls Lua makes on contexts, discarding a previous recording.
+    /// Also available from Lua as rmlui.StartRecording().
+    /// </summary>
+    RMLUILUA_API void StartRecording();
+
+    /// <summary>
+    /// Stops recording.  Also available from Lua as rmlui.StopRecording().
+    /// </summary>
+    /// <returns>The recording as text, one call per line.</returns>
+    RMLUILUA_API Rml::String StopRecording();
+
+    /// <summary>
+    /// Replays a recording into the contexts it names, creating missing contexts, and times each update.
+    /// Load the same documents first.  For deterministic animations, have the system interface return the time passed to set_time.
+    /// </summary>
+    /// <param name="recording">A recording returned by StopRecording.</param>
+    /// <param name="set_time">Called with the recorded elapsed time before each update.  May be empty.</param>
+    /// <returns>The timings of each update.</returns>
+    RMLUILUA_API Rml::Vector<ReplayFrame> Replay(const Rml::String& recording, const Rml::Function<void(double)>& set_time = {});
+
+    /// <summary>
+    /// Limits every event listener, data model event and RunLuaScript call to a budget.
+    /// A call that runs past it is aborted with a Lua error naming the handler, logged like any other script error.
+    /// Under LuaJIT, loops running as compiled traces are only stopped once they leave the trace.
+    /// </summary>
+    /// <param name="max_instructions">Lua instructions per call, checked every 1000 instructions.  0 for no limit.</param>
+    /// <param name="max_ms">Time per call in milliseconds.  0 for no limit.</param>
+    /// <param name="disable_after">Overruns after which an event listener stops running.  0 keeps running listeners.</param>
+    RMLUILUA_API void EnableWatchdog(uint64_t max_instructions, double max_ms = 0.0, int disable_after = 3);
+
+    /// <summary>
+    /// Removes the budget.
+    /// </summary>
+    RMLUILUA_API void DisableWatchdog();
+
+    /// <summary>
+    /// Sets how repeated Lua errors are logged.
+    /// Errors are keyed by chunk and line, or by their first line when they have no position.
+    /// The first one from a place is logged with a traceback, and repeats are logged as a count per interval.
+    /// At most 256 places are kept: a new place replaces the one with the fewest errors.  ResetErrorStats() clears them all.
+    /// The default is one summary every 5 seconds and 20 new places per second.
+    /// </summary>
+    /// <param name="summary_interval">Seconds between summaries of an error that keeps repeating.</param>
+    /// <param name="max_new_per_second">Errors from new places logged per second.  Others are only counted.  0 for no limit.</param>
+    RMLUILUA_API void SetErrorReporting(double summary_interval, int max_new_per_second);
+
+    /// <summary>
+    /// Sends Lua errors to a callback instead of the log.  An empty callback restores logging.
+    /// </summary>
+    RMLUILUA_API void SetErrorCallback(ErrorCallback callback);
+
+    /// <summary>
+    /// Logs the summaries of repeated errors that are due.  Context:Update() called from Lua does this already.
+    /// </summary>
+    RMLUILUA_API void FlushErrorSummaries();
+
+    /// <summary>
+    /// Gets the counts of every place that raised errors, most frequent first.  Also available from Lua as rmlui.ErrorStats().
+    /// </summary>
+    /// <returns>The stats.</returns>
+    RMLUILUA_API Rml::Vector<ErrorStats> GetErrorStats();
+
+    /// <summary>
+    /// Forgets every error and every place, so the next one from each place is logged with a traceback again.
+    /// </summary>
+    RMLUILUA_API void ResetErrorStats();
+
+    /// <summary>
+    /// Sets the least important type that print and Log.Message write.  Filtered calls return before converting their arguments.
+    /// Also available from Lua as Log.SetLevel(type).
+    /// </summary>
+    /// <param name="level">For example LT_WARNING drops info and debug messages.  LT_MAX writes everything.</param>
+    RMLUILUA_API void SetLogLevel(Rml::Log::Type level);
+
+    /// <summary>
+    /// Joins the messages of print and Log.Message and hands them to the system interface once per frame, instead of once per call.
+    /// Context:Update() called from Lua flushes the batch; otherwise call FlushLog() each frame.
+    /// </summary>
+    /// <param name="enabled">Whether to batch.  Turning it off flushes.</param>
+    RMLUILUA_API void EnableLogBatching(bool enabled);
+
+    /// <summary>
+    /// Hands the batched messages to the system interface.
+    /// </summary>
+    RMLUILUA_API void FlushLog();
+
+    /// <summary>
+    /// Sets where require() looks for modules through the RmlUi file interface, so modules can come from archives the file interface reads.
+    /// Searched after package.preload and before the standard searchers.  Open the package library before registering.
+    /// </summary>
+    /// <param name="patterns">Paths where '?' is replaced by the module name, with '.' turned into '/'.  The default is "?.lua" and "?/init.lua".</param>
+    RMLUILUA_API void SetModulePaths(const Rml::StringList& patterns);
+
+    /// <summary>
+    /// Gets the counters of the compiled chunk cache.
+    /// Modules and external document scripts are compiled once per source text, and the bytecode is reused by later loads and other Lua states.
+    /// </summary>
+    /// <returns>The counters.</returns>
+    RMLUILUA_API ChunkCacheStats GetChunkCacheStats();
+
+    /// <summary>
+    /// Drops every compiled chunk.
+    /// </summary>
+    RMLUILUA_API void ClearChunkCache();
+
 } // end namespace Rml::SolLua
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "RmlSolLua.h"
+
+#include <RmlUi/Core/FileInterface.h>
+
+#include <string_view>
+
+
+namespace Rml::SolLua
+{
+    /// <summary>
+    /// A file interface that serves files from memory-mapped bundles made by RmlSolLua_pack, and passes other paths to a fallback.
+    /// Opening a bundled file makes no system calls, and precompiled Lua from a bundle is loaded straight from the mapping by
+    /// document scripts and require().
+    /// Bundled bytecode is trusted as is, so only mount bundles you built.
+    /// </summary>
+    class RMLUILUA_API BundleFileInterface : public Rml::FileInterface
+    {
+    public:
+        /// <param name="fallback">Serves paths that aren't in a bundle.  Can be null.</param>
+        explicit BundleFileInterface(Rml::FileInterface* fallback = nullptr);
+        ~BundleFileInterface() override;
+
+        BundleFileInterface(const BundleFileInterface&) = delete;
+        BundleFileInterface& operator=(const BundleFileInterface&) = delete;
+
+        /// <summary>
+        /// Maps a bundle.  Its files replace bundled files with the same path.
+        /// The mapping stays until the interface is destroyed.
+        /// </summary>
+        /// <param name="path">The bundle file, on disk.</param>
+        /// <returns>False if the bundle couldn't be mapped or is invalid.</returns>
+        bool Mount(const Rml::String& path);
+
+        /// <summary>
+        /// Gets the contents of a bundled file without copying.
+        /// </summary>
+        /// <param name="path">Path of the file, as passed to Open.</param>
+        /// <param name="data">Set to the contents, which stay valid while the interface lives.</param>
+        /// <param name="bytecode">If not null, set to whether RmlSolLua_pack compiled the file to Lua bytecode.</param>
+        /// <returns>False if the file isn't bundled.</returns>
+        bool Find(const Rml::String& path, std::string_view& data, bool* bytecode = nullptr) const;
+
+        Rml::FileHandle Open(const Rml::String& path) override;
+        void Close(Rml::FileHandle file) override;
+        size_t Read(void* buffer, size_t size, Rml::FileHandle file) override;
+        bool Seek(Rml::FileHandle file, long offset, int origin) override;
+        size_t Tell(Rml::FileHandle file) override;
+        size_t Length(Rml::FileHandle file) override;
+
+    private:
+        struct Mapping;
+
+        struct File
+        {
+            std::string_view Data;
+            uint32_t Flags = 0;
+        };
+
+        Rml::FileInterface* m_fallback;
+        Rml::Vector<Rml::UniquePtr<Mapping>> m_mappings;
+        Rml::UnorderedMap<Rml::String, File> m_files;
+    };
+
+} // end namespace Rml::SolLua
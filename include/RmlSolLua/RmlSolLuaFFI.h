@@ -0,0 +1,45 @@
+#pragma once
+
+#include "RmlSolLua.h"
+
+#include <stddef.h>
+
+// Plain C entry points for hot element operations, meant to be called from LuaJIT through ffi.cdef.
+// Only compiled when RmlSolLua is built with the RMLSOLLUA_FFI option.
+//
+// Elements are passed as the raw pointer returned by Element.pointer in Lua.
+// The symbols are resolved through ffi.C, so the host executable must export them
+// (for example -rdynamic / --export-dynamic on Linux, or a DLL build on Windows).
+//
+// Returned strings point to a per-thread buffer and stay valid until the next call on the same thread.
+
+extern "C"
+{
+    /// <summary>
+    /// Box metrics of an element, in the same layout as the table returned by Element:GetBox().
+    /// </summary>
+    typedef struct rmlsollua_box
+    {
+        float offset_left, offset_top, offset_width, offset_height;
+        float client_left, client_top, client_width, client_height;
+        float scroll_left, scroll_top, scroll_width, scroll_height;
+        float absolute_left, absolute_top;
+    } rmlsollua_box;
+
+    RMLUILUA_API void rmlsollua_element_set_class(void* element, const char* name, int activate);
+    RMLUILUA_API int rmlsollua_element_is_class_set(void* element, const char* name);
+
+    RMLUILUA_API void rmlsollua_element_set_attribute(void* element, const char* name, const char* value);
+    RMLUILUA_API const char* rmlsollua_element_get_attribute(void* element, const char* name, size_t* length);
+    RMLUILUA_API int rmlsollua_element_has_attribute(void* element, const char* name);
+    RMLUILUA_API void rmlsollua_element_remove_attribute(void* element, const char* name);
+
+    RMLUILUA_API int rmlsollua_element_set_property(void* element, const char* name, const char* value);
+    RMLUILUA_API const char* rmlsollua_element_get_property(void* element, const char* name, size_t* length);
+    RMLUILUA_API void rmlsollua_element_remove_property(void* element, const char* name);
+
+    RMLUILUA_API void rmlsollua_element_set_inner_rml(void* element, const char* rml);
+    RMLUILUA_API const char* rmlsollua_element_get_inner_rml(void* element, size_t* length);
+
+    RMLUILUA_API void rmlsollua_element_get_box(void* element, rmlsollua_box* box);
+}
@@ -50,4 +50,6 @@ project "RmlSolLua"
 	defines {
 		"RMLUI_STATIC_LIB",
 		-- "RMLUI_NO_THIRDPARTY_CONTAINERS".	-- Enable to use STL containers.
+		-- "SOL_SAFE_USERTYPE=0", "SOL_SAFE_REFERENCES=0", "SOL_SAFE_FUNCTION_CALLS=0", "SOL_SAFE_GETTER=0", "SOL_SAFE_NUMERICS=0",	-- Unchecked bindings, see RMLSOLLUA_UNCHECKED in CMakeLists.txt.
+		-- "RMLSOLLUA_FFI",	-- Enable to export the C API used by require("rmlui.ffi"). The executable must export its symbols.
 	}
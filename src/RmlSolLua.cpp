@@ -4,6 +4,17 @@
 #include <RmlUi/Core.h>
 
 #include "bind/bind.h"
+#include "plugin/SolLuaAllocator.h"
+#include "plugin/SolLuaErrors.h"
+#include "plugin/SolLuaGarbageCollector.h"
+#include "plugin/SolLuaLatency.h"
+#include "plugin/SolLuaLog.h"
+#include "plugin/SolLuaModules.h"
+#include "plugin/SolLuaProfiler.h"
+#include "plugin/SolLuaRecorder.h"
+#include "plugin/SolLuaStats.h"
+#include "plugin/SolLuaTrace.h"
+#include "plugin/SolLuaWatchdog.h"
 #include "plugin/SolLuaPlugin.h"
 
 
@@ -28,6 +39,24 @@ namespace Rml::SolLua
         }
     }
 
+    void InitialiseLazy(sol::state_view* state)
+    {
+        if (state != nullptr)
+        {
+            ::Rml::RegisterPlugin(new SolLuaPlugin(*state));
+            RegisterLuaLazy(state);
+        }
+    }
+
+    void InitialiseLazy(sol::state_view* state, const Rml::String& lua_environment_identifier)
+    {
+        if (state != nullptr)
+        {
+            ::Rml::RegisterPlugin(new SolLuaPlugin(*state, lua_environment_identifier));
+            RegisterLuaLazy(state);
+        }
+    }
+
     void Initialize(sol::state_view* state)
     {
         Initialise(state);
@@ -40,18 +69,174 @@ namespace Rml::SolLua
 
     void RegisterLua(sol::state_view* state)
     {
-        bind_color(*state);
-        bind_context(*state);
-        bind_datamodel(*state);
-        bind_element(*state);
-        bind_element_derived(*state);
-        bind_element_form(*state);
-        bind_document(*state);
-        bind_event(*state);
-        bind_global(*state);
-        bind_log(*state);
-        bind_vector(*state);
-        bind_convert(*state);
+        SolLuaErrors::Install(*state);
+        SolLuaModules::Install(*state);
+        ensureRegistered(*state);
+    }
+
+    void RegisterLuaLazy(sol::state_view* state)
+    {
+        SolLuaErrors::Install(*state);
+        SolLuaModules::Install(*state);
+        bind_lazy(*state);
+    }
+
+    void InstallTrackedAllocator(sol::state_view* state)
+    {
+        if (state != nullptr)
+            SolLuaAllocator::Install(state->lua_state());
+    }
+
+    void EnableManagedGC(sol::state_view* state, double budget_ms)
+    {
+        if (state != nullptr)
+            SolLuaGarbageCollector::Enable(state->lua_state(), budget_ms);
+    }
+
+    void DisableManagedGC(sol::state_view* state)
+    {
+        if (state != nullptr)
+            SolLuaGarbageCollector::Disable(state->lua_state());
+    }
+
+    void StepManagedGC(sol::state_view* state)
+    {
+        if (state == nullptr)
+            return;
+
+        if (auto collector = SolLuaGarbageCollector::Get(state->lua_state()); collector != nullptr)
+            collector->Step();
+    }
+
+    void EnableLatencyTracking(bool enabled, double slow_threshold_ms)
+    {
+        SolLuaLatency::Enable(enabled, slow_threshold_ms);
+    }
+
+    Rml::Vector<LatencyStats> GetLatencyStats()
+    {
+        return SolLuaLatency::GetStats();
+    }
+
+    void ResetLatencyStats()
+    {
+        SolLuaLatency::Reset();
+    }
+
+    void EnableTracing(std::size_t capacity)
+    {
+        SolLuaTrace::Enable(capacity);
+    }
+
+    void DisableTracing()
+    {
+        SolLuaTrace::Disable();
+    }
+
+    Rml::String DumpTrace()
+    {
+        return SolLuaTrace::Dump();
+    }
+
+    void StartProfiler(sol::state_view* state, int hz)
+    {
+        if (state != nullptr)
+            SolLuaProfiler::Start(state->lua_state(), hz);
+    }
+
+    Rml::String StopProfiler()
+    {
+        return SolLuaProfiler::Stop();
+    }
+
+    RuntimeStats GetRuntimeStats(sol::state_view* state)
+    {
+        return SolLuaStats::Collect(state != nullptr ? state->lua_state() : nullptr);
+    }
+
+    void ResetFrameStats()
+    {
+        SolLuaStats::ResetFrame();
+    }
+
+    void StartRecording()
+    {
+        SolLuaRecorder::Start();
+    }
+
+    Rml::String StopRecording()
+    {
+        return SolLuaRecorder::Stop();
+    }
+
+    Rml::Vector<ReplayFrame> Replay(const Rml::String& recording, const Rml::Function<void(double)>& set_time)
+    {
+        return SolLuaRecorder::Replay(recording, set_time);
+    }
+
+    void EnableWatchdog(uint64_t max_instructions, double max_ms, int disable_after)
+    {
+        SolLuaWatchdog::Enable(max_instructions, max_ms, disable_after);
+    }
+
+    void DisableWatchdog()
+    {
+        SolLuaWatchdog::Disable();
+    }
+
+    void SetErrorReporting(double summary_interval, int max_new_per_second)
+    {
+        SolLuaErrors::Configure(summary_interval, max_new_per_second);
+    }
+
+    void SetErrorCallback(ErrorCallback callback)
+    {
+        SolLuaErrors::SetCallback(std::move(callback));
+    }
+
+    void FlushErrorSummaries()
+    {
+        SolLuaErrors::Tick();
+    }
+
+    Rml::Vector<ErrorStats> GetErrorStats()
+    {
+        return SolLuaErrors::GetStats();
+    }
+
+    void ResetErrorStats()
+    {
+        SolLuaErrors::Reset();
+    }
+
+    void SetLogLevel(Rml::Log::Type level)
+    {
+        SolLuaLog::SetLevel(level);
+    }
+
+    void EnableLogBatching(bool enabled)
+    {
+        SolLuaLog::SetBatching(enabled);
+    }
+
+    void FlushLog()
+    {
+        SolLuaLog::Flush();
+    }
+
+    void SetModulePaths(const Rml::StringList& patterns)
+    {
+        SolLuaModules::SetPaths(patterns);
+    }
+
+    ChunkCacheStats GetChunkCacheStats()
+    {
+        return SolLuaModules::GetStats();
+    }
+
+    void ClearChunkCache()
+    {
+        SolLuaModules::Clear();
     }
 
 } // end namespace Rml::SolLua
@@ -19,6 +19,41 @@ namespace Rml::SolLua
 		sol::tie(self.red, self.green, self.blue, self.alpha) = color;
 	}
 
+	template <typename T, int A>
+	void setRGBA4(Rml::Colour<T, A>& self, T red, T green, T blue, T alpha)
+	{
+		self.red = red;
+		self.green = green;
+		self.blue = blue;
+		self.alpha = alpha;
+	}
+
+	namespace colour
+	{
+		// Unboxed colour math on plain numbers, so no userdata is created.
+		using Components = std::tuple<float, float, float, float>;
+
+		Components add(float r1, float g1, float b1, float a1, float r2, float g2, float b2, float a2)
+		{
+			return { r1 + r2, g1 + g2, b1 + b2, a1 + a2 };
+		}
+
+		Components sub(float r1, float g1, float b1, float a1, float r2, float g2, float b2, float a2)
+		{
+			return { r1 - r2, g1 - g2, b1 - b2, a1 - a2 };
+		}
+
+		Components scale(float r, float g, float b, float a, float s)
+		{
+			return { r * s, g * s, b * s, a * s };
+		}
+
+		Components lerp(float r1, float g1, float b1, float a1, float r2, float g2, float b2, float a2, float t)
+		{
+			return { r1 + (r2 - r1) * t, g1 + (g2 - g1) * t, b1 + (b2 - b1) * t, a1 + (a2 - a1) * t };
+		}
+	}
+
 	void bind_color(sol::state_view& lua)
 	{
 		lua.new_usertype<Rml::Colourb>("Colourb", sol::constructors<Rml::Colourb(), Rml::Colourb(Rml::byte, Rml::byte, Rml::byte), Rml::Colourb(Rml::byte, Rml::byte, Rml::byte, Rml::byte)>(),
@@ -42,7 +77,12 @@ namespace Rml::SolLua
 			"green", &Rml::Colourb::green,
 			"blue", &Rml::Colourb::blue,
 			"alpha", &Rml::Colourb::alpha,
-			"rgba", sol::property(static_cast<ColourbTuple(*)(Rml::Colourb&)>(&getRGBA), static_cast<void(*)(Rml::Colourb&, ColourbTuple)>(&setRGBA))
+			"rgba", sol::property(static_cast<ColourbTuple(*)(Rml::Colourb&)>(&getRGBA), static_cast<void(*)(Rml::Colourb&, ColourbTuple)>(&setRGBA)),
+
+			// M
+			//--
+			"Set", static_cast<void(*)(Rml::Colourb&, Rml::byte, Rml::byte, Rml::byte, Rml::byte)>(&setRGBA4),
+			"Unpack", static_cast<ColourbTuple(*)(Rml::Colourb&)>(&getRGBA)
 		);
 
 		lua.new_usertype<Rml::Colourf>("Colourf", sol::constructors<Rml::Colourf(), Rml::Colourf(float, float, float), Rml::Colourf(float, float, float, float)>(),
@@ -66,8 +106,20 @@ namespace Rml::SolLua
 			"green", &Rml::Colourf::green,
 			"blue", &Rml::Colourf::blue,
 			"alpha", &Rml::Colourf::alpha,
-			"rgba", sol::property(static_cast<ColourfTuple(*)(Rml::Colourf&)>(&getRGBA), static_cast<void(*)(Rml::Colourf&, ColourfTuple)>(&setRGBA))
+			"rgba", sol::property(static_cast<ColourfTuple(*)(Rml::Colourf&)>(&getRGBA), static_cast<void(*)(Rml::Colourf&, ColourfTuple)>(&setRGBA)),
+
+			// M
+			//--
+			"Set", static_cast<void(*)(Rml::Colourf&, float, float, float, float)>(&setRGBA4),
+			"Unpack", static_cast<ColourfTuple(*)(Rml::Colourf&)>(&getRGBA)
 		);
+
+		//--
+		auto math = lua.create_named_table("RmlColour");
+		math.set_function("add", &colour::add);
+		math.set_function("sub", &colour::sub);
+		math.set_function("scale", &colour::scale);
+		math.set_function("lerp", &colour::lerp);
 	}
 
 } // end namespace Rml::SolLua
@@ -1,7 +1,13 @@
 #include "bind.h"
 
 #include "plugin/SolLuaDocument.h"
+#include "plugin/SolLuaCallScope.h"
 #include "plugin/SolLuaDataModel.h"
+#include "plugin/SolLuaErrors.h"
+#include "plugin/SolLuaGarbageCollector.h"
+#include "plugin/SolLuaLog.h"
+#include "plugin/SolLuaRecorder.h"
+#include "plugin/SolLuaWatchdog.h"
 
 #include <memory>
 
@@ -47,7 +53,8 @@ namespace Rml::SolLua
 		/// </summary>
 		/// <param name="data">The data model container.</param>
 		/// <param name="table">The table to bind.</param>
-		void bindTable(SolLuaDataModel* data, sol::table& table)
+		/// <param name="name">The name of the data model, used to label event callbacks.</param>
+		void bindTable(SolLuaDataModel* data, sol::table& table, const Rml::String& name)
 		{
 			for (auto& [key, value] : table)
 			{
@@ -57,16 +64,14 @@ namespace Rml::SolLua
 				if (value.get_type() == sol::type::function)
 				{
 					data->Constructor.BindEventCallback(skey,
-						[skey, cb = sol::protected_function{ value }, state = sol::state_view{ table.lua_state() }](Rml::DataModelHandle, Rml::Event& event, const Rml::VariantList& varlist)
+						[label = "[" + name + "] " + skey, cb = sol::protected_function{ value }](Rml::DataModelHandle, Rml::Event& event, const Rml::VariantList& varlist)
 						{
 							if (cb.valid())
 							{
-								std::vector<sol::object> args;
-								for (const auto& variant : varlist)
-								{
-									args.push_back(makeObjectFromVariant(&variant, state));
-								}
-								auto pfr = cb(event, sol::as_args(args));
+								auto target = event.GetTargetElement();
+								SolLuaCallScope scope{ SolLuaStats::CallType::DataEvent, target != nullptr ? target->GetOwnerDocument() : nullptr, &label };
+								SolLuaWatchdog::Scope watchdog{ cb.lua_state(), &label };
+								auto pfr = cb(event, sol::as_args(varlist));
 								if (!pfr.valid())
 									ErrorHandler(cb.lua_state(), std::move(pfr));
 							}
@@ -102,6 +107,11 @@ namespace Rml::SolLua
 				if (!constructor)
 					return data;
 			}
+			else
+			{
+				data->ContextName = self.GetName();
+				data->Name = name;
+			}
 
 			data->Constructor = constructor;
 			data->Handle = constructor.GetModelHandle();
@@ -111,7 +121,7 @@ namespace Rml::SolLua
 			if (model.get_type() == sol::type::table)
 			{
 				data->Table = model.as<sol::table>();
-				datamodel::bindTable(data.get(), data->Table);
+				datamodel::bindTable(data.get(), data->Table, name);
 			}
 
 			return data;
@@ -129,6 +139,92 @@ namespace Rml::SolLua
 		{
 			return self.GetElementAtPoint(point, &ignore);
 		}
+
+		auto getElementAtPoint3(Rml::Context& self, float x, float y)
+		{
+			return self.GetElementAtPoint(Rml::Vector2f(x, y));
+		}
+
+		auto getElementAtPoint4(Rml::Context& self, float x, float y, Rml::Element& ignore)
+		{
+			return self.GetElementAtPoint(Rml::Vector2f(x, y), &ignore);
+		}
+
+		auto getElementAtXY(Rml::Context& self, float x, float y, sol::optional<Rml::Element&> ignore)
+		{
+			return self.GetElementAtPoint(Rml::Vector2f(x, y), ignore ? &*ignore : nullptr);
+		}
+	}
+
+	namespace input
+	{
+		// Each call is recorded when SolLuaRecorder is on, so the session can be replayed.
+
+		bool processMouseMove(Rml::Context& self, int x, int y, int key_modifier_state)
+		{
+			if (SolLuaRecorder::IsRecording())
+				SolLuaRecorder::MouseMove(self, x, y, key_modifier_state);
+			return self.ProcessMouseMove(x, y, key_modifier_state);
+		}
+
+		bool processMouseButtonDown(Rml::Context& self, int button_index, int key_modifier_state)
+		{
+			if (SolLuaRecorder::IsRecording())
+				SolLuaRecorder::MouseButton(self, true, button_index, key_modifier_state);
+			return self.ProcessMouseButtonDown(button_index, key_modifier_state);
+		}
+
+		bool processMouseButtonUp(Rml::Context& self, int button_index, int key_modifier_state)
+		{
+			if (SolLuaRecorder::IsRecording())
+				SolLuaRecorder::MouseButton(self, false, button_index, key_modifier_state);
+			return self.ProcessMouseButtonUp(button_index, key_modifier_state);
+		}
+
+		bool processMouseWheel(Rml::Context& self, float wheel_delta, int key_modifier_state)
+		{
+			if (SolLuaRecorder::IsRecording())
+				SolLuaRecorder::MouseWheel(self, 0.f, wheel_delta, key_modifier_state);
+			return self.ProcessMouseWheel(wheel_delta, key_modifier_state);
+		}
+
+#if RmlUi_VERSION_MAJOR >= 5 && RmlUi_VERSION_MINOR >= 1
+		bool processMouseWheelVector(Rml::Context& self, Rml::Vector2f wheel_delta, int key_modifier_state)
+		{
+			if (SolLuaRecorder::IsRecording())
+				SolLuaRecorder::MouseWheel(self, wheel_delta.x, wheel_delta.y, key_modifier_state);
+			return self.ProcessMouseWheel(wheel_delta, key_modifier_state);
+		}
+#endif
+
+		auto processMouseLeave(Rml::Context& self)
+		{
+			// Returns void before RmlUi 6.
+			if (SolLuaRecorder::IsRecording())
+				SolLuaRecorder::MouseLeave(self);
+			return self.ProcessMouseLeave();
+		}
+
+		bool processKeyDown(Rml::Context& self, Rml::Input::KeyIdentifier key_identifier, int key_modifier_state)
+		{
+			if (SolLuaRecorder::IsRecording())
+				SolLuaRecorder::Key(self, true, key_identifier, key_modifier_state);
+			return self.ProcessKeyDown(key_identifier, key_modifier_state);
+		}
+
+		bool processKeyUp(Rml::Context& self, Rml::Input::KeyIdentifier key_identifier, int key_modifier_state)
+		{
+			if (SolLuaRecorder::IsRecording())
+				SolLuaRecorder::Key(self, false, key_identifier, key_modifier_state);
+			return self.ProcessKeyUp(key_identifier, key_modifier_state);
+		}
+
+		bool processTextInput(Rml::Context& self, const Rml::String& text)
+		{
+			if (SolLuaRecorder::IsRecording())
+				SolLuaRecorder::TextInput(self, text);
+			return self.ProcessTextInput(text);
+		}
 	}
 
 	/// <summary>
@@ -150,29 +246,37 @@ namespace Rml::SolLua
 		usertype["Render"] = &Rml::Context::Render;
 		usertype["UnloadAllDocuments"] = &Rml::Context::UnloadAllDocuments;
 		usertype["UnloadDocument"] = &Rml::Context::UnloadDocument;
-		usertype["Update"] = &Rml::Context::Update;
+		usertype["Update"] = [](Rml::Context& self, sol::this_state s) {
+			if (SolLuaRecorder::IsRecording())
+				SolLuaRecorder::Update(self);
+			auto result = self.Update();
+			if (auto collector = SolLuaGarbageCollector::Get(s); collector != nullptr)
+				collector->StepContext(&self);
+			SolLuaErrors::Tick();
+			SolLuaLog::Flush();
+			return result;
+		};
 		usertype["OpenDataModel"] = &datamodel::openDataModel;
-		usertype["ProcessMouseMove"] = &Rml::Context::ProcessMouseMove;
-		usertype["ProcessMouseButtonDown"] = &Rml::Context::ProcessMouseButtonDown;
-		usertype["ProcessMouseButtonUp"] = &Rml::Context::ProcessMouseButtonUp;
+		usertype["ProcessMouseMove"] = &input::processMouseMove;
+		usertype["ProcessMouseButtonDown"] = &input::processMouseButtonDown;
+		usertype["ProcessMouseButtonUp"] = &input::processMouseButtonUp;
 #if RmlUi_VERSION_MAJOR >= 5 && RmlUi_VERSION_MINOR >= 1
-		usertype["ProcessMouseWheel"] = sol::overload(
-			static_cast<bool(Rml::Context::*)(float, int)>(&Rml::Context::ProcessMouseWheel),
-			static_cast<bool(Rml::Context::*)(Vector2f, int)>(&Rml::Context::ProcessMouseWheel)
-		);
+		usertype["ProcessMouseWheel"] = sol::overload(&input::processMouseWheel, &input::processMouseWheelVector);
+		usertype["ProcessMouseWheelVector"] = &input::processMouseWheelVector;
 #else
-		usertype["ProcessMouseWheel"] = &Rml::Context::ProcessMouseWheel;
+		usertype["ProcessMouseWheel"] = &input::processMouseWheel;
 #endif
-		usertype["ProcessMouseLeave"] = &Rml::Context::ProcessMouseLeave;
+		usertype["ProcessMouseLeave"] = &input::processMouseLeave;
 		usertype["IsMouseInteracting"] = &Rml::Context::IsMouseInteracting;
-		usertype["ProcessKeyDown"] = &Rml::Context::ProcessKeyDown;
-		usertype["ProcessKeyUp"] = &Rml::Context::ProcessKeyUp;
-		usertype["ProcessTextInput"] = sol::resolve<bool(const Rml::String&)>(&Rml::Context::ProcessTextInput);
+		usertype["ProcessKeyDown"] = &input::processKeyDown;
+		usertype["ProcessKeyUp"] = &input::processKeyUp;
+		usertype["ProcessTextInput"] = &input::processTextInput;
 		//--
 		usertype["EnableMouseCursor"] = &Rml::Context::EnableMouseCursor;
 		usertype["ActivateTheme"] = &Rml::Context::ActivateTheme;
 		usertype["IsThemeActive"] = &Rml::Context::IsThemeActive;
-		usertype["GetElementAtPoint"] = sol::overload(&element::getElementAtPoint1, &element::getElementAtPoint2);
+		usertype["GetElementAtPoint"] = sol::overload(&element::getElementAtPoint1, &element::getElementAtPoint2, &element::getElementAtPoint3, &element::getElementAtPoint4);
+		usertype["GetElementAtXY"] = &element::getElementAtXY;
 		usertype["PullDocumentToFront"] = [](Rml::Context& self, SolLuaDocument* document) { self.PullDocumentToFront(document); };
 		usertype["PushDocumentToBack"] = [](Rml::Context& self, SolLuaDocument* document) { self.PushDocumentToBack(document); };
 		usertype["UnfocusDocument"] = [](Rml::Context& self, SolLuaDocument* document) { self.UnfocusDocument(document); };
@@ -15,11 +15,14 @@ namespace Rml::SolLua
 		}
 	}
 
-	void bind_convert(sol::state_view& lua)
+	sol::table bind_convert(sol::state_view& lua)
 	{
 		auto element = lua.create_named_table("Element");
-		auto element_as = element.create_named("As");
+		return element.create_named("As");
+	}
 
+	void bind_convert_as(sol::table& element_as)
+	{
 		element_as["Document"] = &functions::convert<SolLuaDocument>;
 		element_as["ElementText"] = &functions::convert<Rml::ElementText>;
 		element_as["ElementDataGrid"] = &functions::convert<Rml::ElementDataGrid>;
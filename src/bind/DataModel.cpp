@@ -8,13 +8,21 @@ namespace Rml::SolLua
 {
 	namespace functions
 	{
+		// A closed model has no table or handle left, so its variables read as nil and writes are dropped.
+
 		sol::object dataModelGet(SolLuaDataModel& self, const std::string& name, sol::this_state s)
 		{
+			if (!self.Table.valid())
+				return sol::make_object(s, sol::lua_nil);
+
 			return self.Table.get<sol::object>(name);
 		}
 
 		void dataModelSet(SolLuaDataModel& self, const std::string& name, sol::object value, sol::this_state s)
 		{
+			if (!self.Handle || !self.Table.valid())
+				return;
+
 			self.Handle.DirtyVariable(name);
 			self.Table.set(name, value);
 		}
@@ -26,7 +34,9 @@ namespace Rml::SolLua
 		lua.new_usertype<SolLuaDataModel>("SolLuaDataModel", sol::no_constructor,
 			sol::meta_function::index, &functions::dataModelGet,
 			sol::meta_function::new_index, &functions::dataModelSet,
-			sol::meta_function::to_string, pointer_to_string<SolLuaDataModel>("sol.DataModel")
+			sol::meta_function::to_string, pointer_to_string<SolLuaDataModel>("sol.DataModel"),
+			//--
+			"Close", &SolLuaDataModel::Close
 		);
 
 	}
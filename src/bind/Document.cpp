@@ -110,6 +110,7 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::Element>()
 		);
+		bind_element_members(usertype);
 	}
 
 } // end namespace Rml::SolLua
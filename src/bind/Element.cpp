@@ -31,12 +31,71 @@ namespace Rml::SolLua
 			self.AddEventListener(event, e, in_capture_phase);
 		}
 
-		auto getAttribute(Rml::Element& self, const Rml::String& name, sol::this_state s)
+		const Rml::Variant& getAttribute(Rml::Element& self, std::string_view name)
 		{
-			sol::state_view state{ s };
+			// An empty Variant is pushed as nil.
+			static const Rml::Variant empty;
+			auto attr = self.GetAttribute(ScratchString{ name });
+			return attr != nullptr ? *attr : empty;
+		}
+
+		void setAttribute(Rml::Element& self, std::string_view name, std::string_view value)
+		{
+			self.SetAttribute(ScratchString{ name }.str(), ScratchString{ value }.str());
+		}
+
+		bool hasAttribute(Rml::Element& self, std::string_view name)
+		{
+			return self.HasAttribute(ScratchString{ name });
+		}
+
+		void removeAttribute(Rml::Element& self, std::string_view name)
+		{
+			self.RemoveAttribute(ScratchString{ name });
+		}
+
+		void setClass(Rml::Element& self, std::string_view class_name, bool activate)
+		{
+			self.SetClass(ScratchString{ class_name }, activate);
+		}
+
+		bool isClassSet(Rml::Element& self, std::string_view class_name)
+		{
+			return self.IsClassSet(ScratchString{ class_name });
+		}
+
+		bool dispatchEvent(Rml::Element& self, std::string_view type, sol::stack_object parameters)
+		{
+			// The dictionary is reused between calls, so tables with the same keys as the last dispatch overwrite values in place.
+			// RmlUi copies the parameters into the event before any listener runs.
+			Scratch<Rml::Dictionary> dictionary;
+			getDictionary(parameters.lua_state(), parameters.stack_index(), *dictionary);
 
-			auto attr = self.GetAttribute(name);
-			return makeObjectFromVariant(attr, s);
+			return self.DispatchEvent(ScratchString{ type }, *dictionary);
+		}
+
+		bool dispatchRegisteredEvent(Rml::Element& self, Rml::EventId id, sol::variadic_args args)
+		{
+			auto layout = getEventLayout(id);
+			if (layout == nullptr)
+			{
+				Scratch<Rml::Dictionary> empty;
+				empty->clear();
+				return self.DispatchEvent(id, *empty);
+			}
+
+			// Arguments are matched to the registered parameter names by position.
+			lua_State* L = args.lua_state();
+			const auto count = static_cast<std::size_t>(args.size());
+			for (std::size_t i = 0; i < layout->Values.size(); ++i)
+			{
+				if (i < count)
+					*layout->Values[i] = sol::stack::get<Rml::Variant>(L, args.stack_index() + static_cast<int>(i));
+				else
+					*layout->Values[i] = Rml::Variant();
+			}
+
+			return self.DispatchEvent(id, layout->Parameters);
 		}
 
 		auto getElementsByTagName(Rml::Element& self, const Rml::String& tag)
@@ -53,18 +112,9 @@ namespace Rml::SolLua
 			return sol::as_table(result);
 		}
 
-		auto getAttributes(Rml::Element& self, sol::this_state s)
+		const Rml::ElementAttributes& getAttributes(Rml::Element& self)
 		{
-			SolObjectMap result;
-
-			const auto& attributes = self.GetAttributes();
-			for (auto& [key, value] : attributes)
-			{
-				auto object = makeObjectFromVariant(&value, s);
-				result.insert(std::make_pair(key, object));
-			}
-
-			return result;
+			return self.GetAttributes();
 		}
 
 		auto getOwnerDocument(Rml::Element& self)
@@ -80,6 +130,53 @@ namespace Rml::SolLua
 			self.QuerySelectorAll(result, selector);
 			return sol::as_table(result);
 		}
+
+		bool isPointWithinElement(Rml::Element& self, float x, float y)
+		{
+			return self.IsPointWithinElement(Rml::Vector2f(x, y));
+		}
+	}
+
+	/// <summary>
+	/// Fills a table with every offset, client, scroll, and absolute metric of an element.
+	/// </summary>
+	/// <param name="element">The element to measure.</param>
+	/// <param name="table">The table to fill.</param>
+	void fillBoxTable(Rml::Element& element, sol::table& table)
+	{
+		table.raw_set(
+			"offset_left", element.GetOffsetLeft(),
+			"offset_top", element.GetOffsetTop(),
+			"offset_width", element.GetOffsetWidth(),
+			"offset_height", element.GetOffsetHeight(),
+			"client_left", element.GetClientLeft(),
+			"client_top", element.GetClientTop(),
+			"client_width", element.GetClientWidth(),
+			"client_height", element.GetClientHeight(),
+			"scroll_left", element.GetScrollLeft(),
+			"scroll_top", element.GetScrollTop(),
+			"scroll_width", element.GetScrollWidth(),
+			"scroll_height", element.GetScrollHeight(),
+			"absolute_left", element.GetAbsoluteLeft(),
+			"absolute_top", element.GetAbsoluteTop()
+		);
+	}
+
+	namespace geometry
+	{
+		/// <summary>
+		/// Returns all box metrics of the element in one table.
+		/// </summary>
+		/// <param name="self">The element to measure.</param>
+		/// <param name="out">Optional table to fill instead of creating a new one.</param>
+		/// <param name="s">Lua state.</param>
+		/// <returns>The filled table.</returns>
+		sol::table getBox(Rml::Element& self, sol::optional<sol::table> out, sol::this_state s)
+		{
+			sol::table result = out ? *out : sol::state_view{ s }.create_table(0, 14);
+			fillBoxTable(self, result);
+			return result;
+		}
 	}
 
 	namespace child
@@ -91,8 +188,129 @@ namespace Rml::SolLua
 		}
 	}
 
+	namespace apply
+	{
+		/// <summary>
+		/// Sets every attribute in the table with a single attribute change notification.
+		/// </summary>
+		/// <param name="self">The element to change.</param>
+		/// <param name="attributes">Table of attribute names to values.</param>
+		void setAttributes(Rml::Element& self, sol::table attributes)
+		{
+			Rml::ElementAttributes changed;
+			for (auto& [key, value] : attributes)
+			{
+				if (key.get_type() == sol::type::string)
+					changed.emplace(key.as<Rml::String>(), makeVariantFromObject(value));
+			}
+
+			if (!changed.empty())
+				self.SetAttributes(changed);
+		}
+
+		/// <summary>
+		/// Sets every style property in the table.  A value of false removes the property.
+		/// </summary>
+		/// <param name="self">The element to change.</param>
+		/// <param name="properties">Table of property names to values.</param>
+		void setProperties(Rml::Element& self, sol::table properties)
+		{
+			for (auto& [key, value] : properties)
+			{
+				if (key.get_type() != sol::type::string)
+					continue;
+
+				switch (value.get_type())
+				{
+				case sol::type::string:
+				case sol::type::number:
+					self.SetProperty(key.as<Rml::String>(), value.as<Rml::String>());
+					break;
+				case sol::type::boolean:
+					if (!value.as<bool>())
+						self.RemoveProperty(key.as<Rml::String>());
+					break;
+				default:
+					break;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Sets or clears classes.  Accepts both { name = bool } and { "name", "name" } tables.
+		/// </summary>
+		/// <param name="self">The element to change.</param>
+		/// <param name="classes">Table of classes.</param>
+		void setClasses(Rml::Element& self, sol::table classes)
+		{
+			for (auto& [key, value] : classes)
+			{
+				if (key.get_type() == sol::type::string)
+					self.SetClass(key.as<Rml::String>(), value.as<bool>());
+				else if (value.get_type() == sol::type::string)
+					self.SetClass(value.as<Rml::String>(), true);
+			}
+		}
+
+		/// <summary>
+		/// Applies attributes, style properties, and classes in one call.
+		/// </summary>
+		/// <param name="self">The element to change.</param>
+		/// <param name="changes">Table with optional attributes, style, and classes sub-tables.</param>
+		void apply(Rml::Element& self, sol::table changes)
+		{
+			if (auto attributes = changes.get<sol::optional<sol::table>>("attributes"); attributes)
+				setAttributes(self, *attributes);
+			if (auto style = changes.get<sol::optional<sol::table>>("style"); style)
+				setProperties(self, *style);
+			if (auto classes = changes.get<sol::optional<sol::table>>("classes"); classes)
+				setClasses(self, *classes);
+		}
+	}
+
 	namespace style
 	{
+		struct UnitName
+		{
+			std::string_view Name;
+			Rml::Property::Unit Unit;
+		};
+
+		constexpr UnitName unitNames[] = {
+			{ "", Rml::Property::NUMBER },
+			{ "px", Rml::Property::PX },
+			{ "dp", Rml::Property::DP },
+			{ "em", Rml::Property::EM },
+			{ "rem", Rml::Property::REM },
+			{ "%", Rml::Property::PERCENT },
+			{ "vw", Rml::Property::VW },
+			{ "vh", Rml::Property::VH },
+			{ "deg", Rml::Property::DEG },
+			{ "rad", Rml::Property::RAD },
+			{ "in", Rml::Property::INCH },
+			{ "cm", Rml::Property::CM },
+			{ "mm", Rml::Property::MM },
+			{ "pt", Rml::Property::PT },
+			{ "pc", Rml::Property::PC }
+		};
+
+		/// <summary>
+		/// Looks up a property id, caching the result so repeated writes skip the style sheet specification.
+		/// </summary>
+		/// <param name="name">The property name.</param>
+		/// <returns>The property id, or PropertyId::Invalid for unknown and shorthand properties.</returns>
+		Rml::PropertyId getPropertyId(const Rml::String& name)
+		{
+			static Rml::UnorderedMap<Rml::String, Rml::PropertyId> cache;
+			if (auto it = cache.find(name); it != cache.end())
+				return it->second;
+
+			auto id = Rml::StyleSheetSpecification::GetPropertyId(name);
+			if (id != Rml::PropertyId::Invalid)
+				cache.emplace(name, id);
+			return id;
+		}
+
 		struct StyleProxyIter
 		{
 			StyleProxyIter(Rml::PropertiesIteratorView&& self) : Iterator(std::move(self)) {}
@@ -115,16 +333,63 @@ namespace Rml::SolLua
 		{
 			StyleProxy(Rml::Element& element) : m_element(element) {}
 
-			std::string Get(const std::string& name)
+			std::string Get(std::string_view name)
 			{
-				auto prop = m_element.GetProperty(name);
+				auto prop = m_element.GetProperty(ScratchString{ name });
 				if (prop == nullptr) return {};
 				return prop->ToString();
 			}
 
-			void Set(const std::string& name, const std::string& value)
+			void Set(std::string_view name, std::string_view value)
 			{
-				m_element.SetProperty(name, value);
+				m_element.SetProperty(ScratchString{ name }.str(), ScratchString{ value }.str());
+			}
+
+			/// <summary>
+			/// Sets a numeric property directly, without formatting and parsing a string.
+			/// </summary>
+			/// <param name="name">The property name.  Shorthands are not supported.</param>
+			/// <param name="value">The numeric value.</param>
+			/// <param name="unit">The unit name, such as "px" or "%".  A plain number if omitted.</param>
+			/// <returns>True if the property was set.</returns>
+			bool SetNumber(std::string_view name, float value, sol::optional<std::string_view> unit)
+			{
+				auto id = getPropertyId(ScratchString{ name });
+				if (id == Rml::PropertyId::Invalid)
+					return false;
+
+				auto unit_name = unit.value_or(std::string_view{});
+				for (const auto& entry : unitNames)
+				{
+					if (entry.Name == unit_name)
+						return m_element.SetProperty(id, Rml::Property(value, entry.Unit));
+				}
+
+				return false;
+			}
+
+			/// <summary>
+			/// Gets a numeric property without converting it to a string.
+			/// </summary>
+			/// <param name="name">The property name.</param>
+			/// <returns>The value and unit name, or nil if the property is not numeric.</returns>
+			std::tuple<sol::optional<float>, sol::optional<std::string_view>> GetNumber(std::string_view name)
+			{
+				auto id = getPropertyId(ScratchString{ name });
+				if (id == Rml::PropertyId::Invalid)
+					return {};
+
+				auto prop = m_element.GetProperty(id);
+				if (prop == nullptr)
+					return {};
+
+				for (const auto& entry : unitNames)
+				{
+					if (entry.Unit == prop->unit)
+						return std::make_tuple(prop->Get<float>(), entry.Name);
+				}
+
+				return {};
 			}
 
 			auto Pairs()
@@ -143,25 +408,9 @@ namespace Rml::SolLua
 		}
 	}
 
-	void bind_element(sol::state_view& lua)
+	template <typename T>
+	void bind_element_members(sol::usertype<T>& elementUsertype)
 	{
-		lua.new_usertype<Rml::EventListener>("EventListener", sol::no_constructor,
-			// M
-			"OnAttach", &Rml::EventListener::OnAttach,
-			"OnDetach", &Rml::EventListener::OnDetach,
-			"ProcessEvent", &Rml::EventListener::ProcessEvent
-		);
-
-		///////////////////////////
-
-		lua.new_usertype<style::StyleProxy>("StyleProxy", sol::no_constructor,
-			sol::meta_function::index, &style::StyleProxy::Get,
-			sol::meta_function::new_index, &style::StyleProxy::Set,
-			sol::meta_function::pairs, &style::StyleProxy::Pairs
-		);
-
-		auto elementUsertype = lua.new_usertype<Rml::Element>("Element", sol::no_constructor);
-		elementUsertype[sol::meta_function::to_string] = pointer_to_string<Rml::Element>("sol.Element");
 		// M
 		elementUsertype["AddEventListener"] = sol::overload(
 			[](Rml::Element& s, const Rml::String& e, sol::protected_function f) { functions::addEventListener(s, e, f, false); },
@@ -169,39 +418,29 @@ namespace Rml::SolLua
 			sol::resolve<void(Rml::Element&, const Rml::String&, const Rml::String&, sol::this_state)>(&functions::addEventListener),
 			sol::resolve<void(Rml::Element&, const Rml::String&, const Rml::String&, sol::this_state, bool)>(&functions::addEventListener)
 		);
+		elementUsertype["AddEventCallback"] = [](Rml::Element& s, const Rml::String& e, sol::protected_function f, sol::optional<bool> in_capture_phase) {
+			functions::addEventListener(s, e, f, in_capture_phase.value_or(false));
+		};
 		elementUsertype["AppendChild"] = [](Rml::Element& self, Rml::ElementPtr& e) { self.AppendChild(std::move(e)); };
 		elementUsertype["Blur"] = &Rml::Element::Blur;
 		elementUsertype["Click"] = &Rml::Element::Click;
-		elementUsertype["DispatchEvent"] = sol::overload(
-			sol::resolve<bool(const Rml::String&, const Rml::Dictionary&)>(&Rml::Element::DispatchEvent),
-			[](Rml::Element& s, const Rml::String& event, sol::table parameters)
-			{
-				Rml::Dictionary parameters2;
-				for(auto kv : parameters)
-				{
-					auto key = kv.first.as<sol::optional<std::string>>();
-					if(key)
-						parameters2[*key] = makeVariantFromObject(kv.second);
-				}
-				s.DispatchEvent(event, parameters2);
-			}
-		);
+		elementUsertype["DispatchEvent"] = &functions::dispatchEvent;
 		elementUsertype["Focus"] = &Rml::Element::Focus;
 		elementUsertype["GetAttribute"] = &functions::getAttribute;
 		elementUsertype["GetElementById"] = &Rml::Element::GetElementById;
 		elementUsertype["GetElementsByTagName"] = &functions::getElementsByTagName;
 		elementUsertype["QuerySelector"] = &Rml::Element::QuerySelector;
 		elementUsertype["QuerySelectorAll"] = &functions::getQuerySelectorAll;
-		elementUsertype["HasAttribute"] = &Rml::Element::HasAttribute;
+		elementUsertype["HasAttribute"] = &functions::hasAttribute;
 		elementUsertype["HasChildNodes"] = &Rml::Element::HasChildNodes;
 		elementUsertype["InsertBefore"] = [](Rml::Element& self, Rml::ElementPtr& element, Rml::Element* adjacent_element) { self.InsertBefore(std::move(element), adjacent_element); };
-		elementUsertype["IsClassSet"] = &Rml::Element::IsClassSet;
-		elementUsertype["RemoveAttribute"] = &Rml::Element::RemoveAttribute;
+		elementUsertype["IsClassSet"] = &functions::isClassSet;
+		elementUsertype["RemoveAttribute"] = &functions::removeAttribute;
 		elementUsertype["RemoveChild"] = &Rml::Element::RemoveChild;
 		elementUsertype["ReplaceChild"] = [](Rml::Element& self, Rml::ElementPtr& inserted_element, Rml::Element* replaced_element) { self.ReplaceChild(std::move(inserted_element), replaced_element); };
 		elementUsertype["ScrollIntoView"] = [](Rml::Element& self, sol::variadic_args va) { if (va.size() == 0) self.ScrollIntoView(true); else self.ScrollIntoView(va[0].as<bool>()); };
-		elementUsertype["SetAttribute"] = static_cast<void(Rml::Element::*)(const Rml::String&, const Rml::String&)>(&Rml::Element::SetAttribute);
-		elementUsertype["SetClass"] = &Rml::Element::SetClass;
+		elementUsertype["SetAttribute"] = &functions::setAttribute;
+		elementUsertype["SetClass"] = &functions::setClass;
 		//--
 		elementUsertype["GetElementsByClassName"] = &functions::getElementsByClassName;
 		elementUsertype["Clone"] = &Rml::Element::Clone;
@@ -210,8 +449,14 @@ namespace Rml::SolLua
 		elementUsertype["IsPseudoClassSet"] = &Rml::Element::IsPseudoClassSet;
 		elementUsertype["ArePseudoClassesSet"] = &Rml::Element::ArePseudoClassesSet;
 		elementUsertype["GetActivePseudoClasses"] = &Rml::Element::GetActivePseudoClasses;
-		elementUsertype["IsPointWithinElement"] = &Rml::Element::IsPointWithinElement;
+		elementUsertype["IsPointWithinElement"] = sol::overload(&Rml::Element::IsPointWithinElement, &functions::isPointWithinElement);
 		elementUsertype["ProcessDefaultAction"] = &Rml::Element::ProcessDefaultAction;
+		elementUsertype["Apply"] = &apply::apply;
+		elementUsertype["SetAttributes"] = &apply::setAttributes;
+		elementUsertype["SetProperties"] = &apply::setProperties;
+		elementUsertype["SetClasses"] = &apply::setClasses;
+		elementUsertype["GetBox"] = &geometry::getBox;
+		elementUsertype["DispatchRegisteredEvent"] = &functions::dispatchRegisteredEvent;
 
 		// G+S
 		elementUsertype["class_name"] = sol::property(&Rml::Element::GetClassNames, &Rml::Element::SetClassNames);
@@ -250,6 +495,51 @@ namespace Rml::SolLua
 		elementUsertype["line_height"] = sol::readonly_property(&Rml::Element::GetLineHeight);
 		elementUsertype["visible"] = sol::readonly_property(&Rml::Element::IsVisible);
 		elementUsertype["z_index"] = sol::readonly_property(&Rml::Element::GetZIndex);
+#ifdef RMLSOLLUA_FFI
+		// Raw element pointer for the functions in require("rmlui.ffi").
+		elementUsertype["pointer"] = sol::readonly_property([](Rml::Element& self) { return static_cast<void*>(&self); });
+#endif
+	}
+
+	// Every usertype deriving from Element gets its own copy of the members so lookups never walk the base class chain.
+	template void bind_element_members(sol::usertype<Rml::Element>&);
+	template void bind_element_members(sol::usertype<SolLuaDocument>&);
+	template void bind_element_members(sol::usertype<Rml::ElementText>&);
+	template void bind_element_members(sol::usertype<Rml::ElementDataGrid>&);
+	template void bind_element_members(sol::usertype<Rml::ElementDataGridRow>&);
+	template void bind_element_members(sol::usertype<Rml::ElementDataGridCell>&);
+	template void bind_element_members(sol::usertype<Rml::ElementTabSet>&);
+	template void bind_element_members(sol::usertype<Rml::ElementProgress>&);
+	template void bind_element_members(sol::usertype<Rml::ElementForm>&);
+	template void bind_element_members(sol::usertype<Rml::ElementFormControl>&);
+	template void bind_element_members(sol::usertype<Rml::ElementFormControlInput>&);
+	template void bind_element_members(sol::usertype<Rml::ElementFormControlSelect>&);
+	template void bind_element_members(sol::usertype<Rml::ElementFormControlDataSelect>&);
+	template void bind_element_members(sol::usertype<Rml::ElementFormControlTextArea>&);
+
+	void bind_element(sol::state_view& lua)
+	{
+		lua.new_usertype<Rml::EventListener>("EventListener", sol::no_constructor,
+			// M
+			"OnAttach", &Rml::EventListener::OnAttach,
+			"OnDetach", &Rml::EventListener::OnDetach,
+			"ProcessEvent", &Rml::EventListener::ProcessEvent
+		);
+
+		///////////////////////////
+
+		lua.new_usertype<style::StyleProxy>("StyleProxy", sol::no_constructor,
+			sol::meta_function::index, &style::StyleProxy::Get,
+			sol::meta_function::new_index, &style::StyleProxy::Set,
+			sol::meta_function::pairs, &style::StyleProxy::Pairs,
+			//--
+			"SetNumber", &style::StyleProxy::SetNumber,
+			"GetNumber", &style::StyleProxy::GetNumber
+		);
+
+		auto elementUsertype = lua.new_usertype<Rml::Element>("Element", sol::no_constructor);
+		elementUsertype[sol::meta_function::to_string] = pointer_to_string<Rml::Element>("sol.Element");
+		bind_element_members(elementUsertype);
 	}
 
 } // end namespace Rml::SolLua
@@ -11,7 +11,7 @@ namespace Rml::SolLua
 	void bind_element_derived(sol::state_view& lua)
 	{
 
-		lua.new_usertype<Rml::ElementText>("ElementText", sol::no_constructor,
+		auto textUsertype = lua.new_usertype<Rml::ElementText>("ElementText", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<Rml::ElementText>("sol.ElementText"),
 			// G
 			"text", sol::property(&Rml::ElementText::GetText, &Rml::ElementText::SetText),
@@ -19,10 +19,11 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::Element>()
 		);
+		bind_element_members(textUsertype);
 
 		///////////////////////////
 
-		lua.new_usertype<Rml::ElementDataGrid>("ElementDataGrid", sol::no_constructor,
+		auto dataGridUsertype = lua.new_usertype<Rml::ElementDataGrid>("ElementDataGrid", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<Rml::ElementDataGrid>("sol.ElementDataGrid"),
 			// M
 			"AddColumn", sol::resolve<bool(const Rml::String&, const Rml::String&, float, const Rml::String&)>(&Rml::ElementDataGrid::AddColumn),
@@ -34,8 +35,9 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::Element>()
 		);
+		bind_element_members(dataGridUsertype);
 
-		lua.new_usertype<Rml::ElementDataGridRow>("ElementDataGridRow", sol::no_constructor,
+		auto dataGridRowUsertype = lua.new_usertype<Rml::ElementDataGridRow>("ElementDataGridRow", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<Rml::ElementDataGridRow>("sol.ElementDataGridRow"),
 			// M
 			//--
@@ -53,9 +55,10 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::Element>()
 		);
+		bind_element_members(dataGridRowUsertype);
 
 		//--
-		lua.new_usertype<Rml::ElementDataGridCell>("ElementDataGridCell", sol::no_constructor,
+		auto dataGridCellUsertype = lua.new_usertype<Rml::ElementDataGridCell>("ElementDataGridCell", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<Rml::ElementDataGridCell>("sol.ElementDataGridCell"),
 			// G
 			//--
@@ -64,10 +67,11 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::Element>()
 		);
+		bind_element_members(dataGridCellUsertype);
 
 		///////////////////////////
 
-		lua.new_usertype<Rml::ElementTabSet>("ElementTabSet", sol::no_constructor,
+		auto tabSetUsertype = lua.new_usertype<Rml::ElementTabSet>("ElementTabSet", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<Rml::ElementTabSet>("sol.ElementTabSet"),
 			// M
 			"SetPanel", sol::resolve<void(int, const Rml::String&)>(&Rml::ElementTabSet::SetPanel),
@@ -93,11 +97,12 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::Element>()
 		);
+		bind_element_members(tabSetUsertype);
 
 		///////////////////////////
 
 		//--
-		lua.new_usertype<Rml::ElementProgress>("ElementProgress", sol::no_constructor,
+		auto progressUsertype = lua.new_usertype<Rml::ElementProgress>("ElementProgress", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<Rml::ElementProgress>("sol.ElementProgress"),
 			// G+S
 			//--
@@ -107,6 +112,7 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::Element>()
 		);
+		bind_element_members(progressUsertype);
 	}
 
 } // end namespace Rml::SolLua
@@ -60,10 +60,76 @@ namespace Rml::SolLua
 		}
 	}
 
+	template <typename T>
+	void bind_form_control_members(sol::usertype<T>& usertype)
+	{
+		// G+S
+		usertype["disabled"] = sol::property(&Rml::ElementFormControl::IsDisabled, &Rml::ElementFormControl::SetDisabled);
+		usertype["name"] = sol::property(&Rml::ElementFormControl::GetName, &Rml::ElementFormControl::SetName);
+		usertype["value"] = sol::property(&Rml::ElementFormControl::GetValue, &Rml::ElementFormControl::SetValue);
+
+		// G
+		//--
+		usertype["submitted"] = sol::readonly_property(&Rml::ElementFormControl::IsSubmitted);
+	}
+
+	template <typename T>
+	void bind_select_members(sol::usertype<T>& usertype)
+	{
+		// M
+		usertype["Add"] = sol::overload(
+			[](Rml::ElementFormControlSelect& self, Rml::ElementPtr& element, sol::optional<int> before)
+			{
+				return self.Add(std::move(element), from_lua_index(before.value_or(0)));
+			},
+			[](
+				Rml::ElementFormControlSelect& self,
+				const Rml::String& rml,
+				const Rml::String& value,
+				std::optional<int> before)
+			{
+				return self.Add(rml, value, from_lua_index(before.value_or(0)));
+			}
+		);
+		usertype["Remove"] = [](Rml::ElementFormControlSelect& self, int index)
+		{
+			self.Remove(from_lua_index(index));
+		};
+		usertype["RemoveAll"] = &Rml::ElementFormControlSelect::RemoveAll;
+
+		// G+S
+		usertype["selection"] = sol::property(
+			[](const Rml::ElementFormControlSelect& self) -> int
+			{
+				return to_lua_index(self.GetSelection());
+			},
+			[](Rml::ElementFormControlSelect& self, int v)
+			{
+				self.SetSelection(from_lua_index(v));
+			}
+		);
+
+		// G
+		usertype["options"] = sol::property([](Rml::ElementFormControlSelect& self, sol::this_state state) -> sol::table
+		{
+			sol::state_view lua(state);
+			auto result = lua.create_table();
+			int i = 0;
+			while (auto element = self.GetOption(i++))
+			{
+				auto luaElement = lua.create_table();
+				luaElement["element"] = element;
+				luaElement["value"] = element->GetAttribute("value", std::string{});
+				result.add(luaElement);
+			}
+			return result;
+		});
+	}
+
 	void bind_element_form(sol::state_view& lua)
 	{
 
-		lua.new_usertype<Rml::ElementForm>("ElementForm", sol::no_constructor,
+		auto formUsertype = lua.new_usertype<Rml::ElementForm>("ElementForm", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<ElementForm>("sol.ElementForm"),
 			// M
 			"Submit", sol::overload(&submit::submit, &submit::submitName, &submit::submitNameValue),
@@ -71,27 +137,22 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::Element>()
 		);
+		bind_element_members(formUsertype);
 
 		///////////////////////////
 
-		lua.new_usertype<Rml::ElementFormControl>("ElementFormControl", sol::no_constructor,
+		auto formControlUsertype = lua.new_usertype<Rml::ElementFormControl>("ElementFormControl", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<ElementFormControl>("sol.ElementFormControl"),
-			// G+S
-			"disabled", sol::property(&Rml::ElementFormControl::IsDisabled, &Rml::ElementFormControl::SetDisabled),
-			"name", sol::property(&Rml::ElementFormControl::GetName, &Rml::ElementFormControl::SetName),
-			"value", sol::property(&Rml::ElementFormControl::GetValue, &Rml::ElementFormControl::SetValue),
-
-			// G
-			//--
-			"submitted", sol::readonly_property(&Rml::ElementFormControl::IsSubmitted),
 
 			// B
 			sol::base_classes, sol::bases<Rml::Element>()
 		);
+		bind_form_control_members(formControlUsertype);
+		bind_element_members(formControlUsertype);
 
 		///////////////////////////
 
-		lua.new_usertype<Rml::ElementFormControlInput>("ElementFormControlInput", sol::no_constructor,
+		auto inputUsertype = lua.new_usertype<Rml::ElementFormControlInput>("ElementFormControlInput", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<ElementFormControlInput>("sol.ElementFormControlInput"),
 
 			// M
@@ -121,67 +182,24 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::ElementFormControl, Rml::Element>()
 		);
+		bind_form_control_members(inputUsertype);
+		bind_element_members(inputUsertype);
 
 		///////////////////////////
 
-		lua.new_usertype<Rml::ElementFormControlSelect>("ElementFormControlSelect", sol::no_constructor,
+		auto selectUsertype = lua.new_usertype<Rml::ElementFormControlSelect>("ElementFormControlSelect", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<ElementFormControlSelect>("sol.ElementFormControlSelect"),
-			// M
-			"Add", sol::overload(
-				[](Rml::ElementFormControlSelect& self, Rml::ElementPtr& element, sol::optional<int> before)
-				{
-					return self.Add(std::move(element), from_lua_index(before.value_or(0)));
-				},
-				[](
-					Rml::ElementFormControlSelect& self,
-					const Rml::String& rml,
-					const Rml::String& value,
-					std::optional<int> before)
-				{
-					return self.Add(rml, value, from_lua_index(before.value_or(0)));
-				}
-			),
-			"Remove", [](Rml::ElementFormControlSelect& self, int index)
-			{
-				self.Remove(from_lua_index(index));
-			},
-			"RemoveAll", &Rml::ElementFormControlSelect::RemoveAll,
-
-			// G+S
-			"selection", sol::property(
-				[](const Rml::ElementFormControlSelect& self) -> int
-				{
-					return to_lua_index(self.GetSelection());
-				},
-				[](Rml::ElementFormControlSelect& self, int v)
-				{
-					self.SetSelection(from_lua_index(v));
-				}
-			),
-
-			// G
-			"options", sol::property([](Rml::ElementFormControlSelect& self, sol::this_state state) -> sol::table
-			{
-				sol::state_view lua(state);
-				auto result = lua.create_table();
-				int i = 0;
-				while (auto element = self.GetOption(i++))
-				{
-					auto luaElement = lua.create_table();
-					luaElement["element"] = element;
-					luaElement["value"] = element->GetAttribute("value", std::string{});
-					result.add(luaElement);
-				}
-				return result;
-			}),
 
 			// B
 			sol::base_classes, sol::bases<Rml::ElementFormControl, Rml::Element>()
 		);
+		bind_select_members(selectUsertype);
+		bind_form_control_members(selectUsertype);
+		bind_element_members(selectUsertype);
 
 		///////////////////////////
 
-		lua.new_usertype<Rml::ElementFormControlDataSelect>("ElementFormControlDataSelect", sol::no_constructor,
+		auto dataSelectUsertype = lua.new_usertype<Rml::ElementFormControlDataSelect>("ElementFormControlDataSelect", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<ElementFormControlDataSelect>("sol.ElementFormControlDataSelect"),
 			// M
 			"SetDataSource", &Rml::ElementFormControlDataSelect::SetDataSource,
@@ -189,10 +207,13 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::ElementFormControlSelect, Rml::ElementFormControl, Rml::Element>()
 		);
+		bind_select_members(dataSelectUsertype);
+		bind_form_control_members(dataSelectUsertype);
+		bind_element_members(dataSelectUsertype);
 
 		///////////////////////////
 
-		lua.new_usertype<Rml::ElementFormControlTextArea>("ElementFormControlTextArea", sol::no_constructor,
+		auto textAreaUsertype = lua.new_usertype<Rml::ElementFormControlTextArea>("ElementFormControlTextArea", sol::no_constructor,
 			sol::meta_function::to_string, pointer_to_string<ElementFormControlTextArea>("sol.ElementFormControlTextArea"),
 			// G+S
 			"cols", sol::property(&Rml::ElementFormControlTextArea::GetNumColumns, &Rml::ElementFormControlTextArea::SetNumColumns),
@@ -203,6 +224,8 @@ namespace Rml::SolLua
 			// B
 			sol::base_classes, sol::bases<Rml::ElementFormControl, Rml::Element>()
 		);
+		bind_form_control_members(textAreaUsertype);
+		bind_element_members(textAreaUsertype);
 
 	}
 
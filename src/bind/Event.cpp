@@ -6,29 +6,59 @@ namespace Rml::SolLua
 
 	namespace functions
 	{
-		SolObjectMap getParameters(Rml::Event& self, sol::this_state s)
+		sol::table getParameters(Rml::Event& self, sol::this_state s)
 		{
-			SolObjectMap result;
+			sol::state_view lua{ s };
 
 			const auto& parameters = self.GetParameters();
+			auto result = lua.create_table(0, static_cast<int>(parameters.size()));
 			for (auto& [key, value] : parameters)
 			{
 				if (self.GetId() == Rml::EventId::Tabchange && value.GetType() == Rml::Variant::INT)
-				{
-					auto object = sol::make_object(s, to_lua_index(value.Get<int>()));
-					result.insert(std::make_pair(key, object));
-				}
+					result.raw_set(key, to_lua_index(value.Get<int>()));
 				else
-				{
-					auto object = makeObjectFromVariant(&value, s);
-					result.insert(std::make_pair(key, object));
-				}
+					result.raw_set(key, value);
 			}
 
 			return result;
 		}
 	}
 
+	namespace layout
+	{
+		Rml::Vector<Rml::UniquePtr<EventLayout>>& getLayouts()
+		{
+			// Indexed by EventId.  Ids are small and sequential, so no hashing is needed to find a layout.
+			static Rml::Vector<Rml::UniquePtr<EventLayout>> layouts;
+			return layouts;
+		}
+	}
+
+	void setEventLayout(Rml::EventId id, const Rml::StringList& names)
+	{
+		auto& layouts = layout::getLayouts();
+		const auto index = static_cast<std::size_t>(id);
+		if (layouts.size() <= index)
+			layouts.resize(index + 1);
+
+		auto result = Rml::MakeUnique<EventLayout>();
+		for (const auto& name : names)
+			result->Parameters[name] = Rml::Variant();
+
+		// Nothing is inserted after this point, so the value pointers stay valid.
+		for (const auto& name : names)
+			result->Values.push_back(&result->Parameters[name]);
+
+		layouts[index] = std::move(result);
+	}
+
+	EventLayout* getEventLayout(Rml::EventId id)
+	{
+		auto& layouts = layout::getLayouts();
+		const auto index = static_cast<std::size_t>(id);
+		return index < layouts.size() ? layouts[index].get() : nullptr;
+	}
+
 	void bind_event(sol::state_view& lua)
 	{
 		//--
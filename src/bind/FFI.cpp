@@ -0,0 +1,186 @@
+#ifdef RMLSOLLUA_FFI
+
+#include "bind.h"
+
+#include "RmlSolLua/RmlSolLuaFFI.h"
+
+
+namespace Rml::SolLua
+{
+
+	namespace ffi
+	{
+		Rml::Element* toElement(void* element)
+		{
+			return static_cast<Rml::Element*>(element);
+		}
+
+		const char* returnString(Rml::String&& value, size_t* length)
+		{
+			thread_local Rml::String buffer;
+			buffer = std::move(value);
+			if (length != nullptr)
+				*length = buffer.size();
+			return buffer.c_str();
+		}
+
+		// Loaded with require("rmlui.ffi") under LuaJIT.
+		// Every function takes the pointer from Element.pointer, so scripts should cache it once per element.
+		constexpr const char* Module = R"lua(
+local ffi = require("ffi")
+
+ffi.cdef[[
+typedef struct rmlsollua_box {
+	float offset_left, offset_top, offset_width, offset_height;
+	float client_left, client_top, client_width, client_height;
+	float scroll_left, scroll_top, scroll_width, scroll_height;
+	float absolute_left, absolute_top;
+} rmlsollua_box;
+
+void rmlsollua_element_set_class(void* element, const char* name, int activate);
+int rmlsollua_element_is_class_set(void* element, const char* name);
+void rmlsollua_element_set_attribute(void* element, const char* name, const char* value);
+const char* rmlsollua_element_get_attribute(void* element, const char* name, size_t* length);
+int rmlsollua_element_has_attribute(void* element, const char* name);
+void rmlsollua_element_remove_attribute(void* element, const char* name);
+int rmlsollua_element_set_property(void* element, const char* name, const char* value);
+const char* rmlsollua_element_get_property(void* element, const char* name, size_t* length);
+void rmlsollua_element_remove_property(void* element, const char* name);
+void rmlsollua_element_set_inner_rml(void* element, const char* rml);
+const char* rmlsollua_element_get_inner_rml(void* element, size_t* length);
+void rmlsollua_element_get_box(void* element, rmlsollua_box* box);
+]]
+
+local C = ffi.C
+local length = ffi.new("size_t[1]")
+
+local function result(str)
+	if str == nil then return nil end
+	return ffi.string(str, length[0])
+end
+
+local M = {}
+
+function M.SetClass(p, name, activate) C.rmlsollua_element_set_class(p, name, activate and 1 or 0) end
+function M.IsClassSet(p, name) return C.rmlsollua_element_is_class_set(p, name) ~= 0 end
+function M.SetAttribute(p, name, value) C.rmlsollua_element_set_attribute(p, name, tostring(value)) end
+function M.GetAttribute(p, name) return result(C.rmlsollua_element_get_attribute(p, name, length)) end
+function M.HasAttribute(p, name) return C.rmlsollua_element_has_attribute(p, name) ~= 0 end
+function M.RemoveAttribute(p, name) C.rmlsollua_element_remove_attribute(p, name) end
+function M.SetProperty(p, name, value) return C.rmlsollua_element_set_property(p, name, value) ~= 0 end
+function M.GetProperty(p, name) return result(C.rmlsollua_element_get_property(p, name, length)) end
+function M.RemoveProperty(p, name) C.rmlsollua_element_remove_property(p, name) end
+function M.SetInnerRML(p, rml) C.rmlsollua_element_set_inner_rml(p, rml) end
+function M.GetInnerRML(p) return result(C.rmlsollua_element_get_inner_rml(p, length)) end
+
+-- Fills and returns box, or a new rmlsollua_box cdata.
+function M.GetBox(p, box)
+	box = box or ffi.new("rmlsollua_box")
+	C.rmlsollua_element_get_box(p, box)
+	return box
+end
+
+return M
+)lua";
+	}
+
+	void bind_ffi(sol::state_view& lua)
+	{
+		// Without the package library there is no require to load the module with.
+		auto package = lua["package"].get<sol::optional<sol::table>>();
+		if (!package)
+			return;
+		auto preload = package->get<sol::optional<sol::table>>("preload");
+		if (!preload)
+			return;
+
+		// The module is only useful under LuaJIT, but registering it elsewhere is harmless: require fails on "ffi".
+		preload->set("rmlui.ffi", [](sol::this_state s) {
+			return sol::state_view{ s }.script(ffi::Module, "=rmlui.ffi").get<sol::object>();
+		});
+	}
+
+} // end namespace Rml::SolLua
+
+
+using Rml::SolLua::ffi::toElement;
+using Rml::SolLua::ffi::returnString;
+
+extern "C"
+{
+
+	void rmlsollua_element_set_class(void* element, const char* name, int activate)
+	{
+		toElement(element)->SetClass(name, activate != 0);
+	}
+
+	int rmlsollua_element_is_class_set(void* element, const char* name)
+	{
+		return toElement(element)->IsClassSet(name) ? 1 : 0;
+	}
+
+	void rmlsollua_element_set_attribute(void* element, const char* name, const char* value)
+	{
+		toElement(element)->SetAttribute(name, Rml::String(value));
+	}
+
+	const char* rmlsollua_element_get_attribute(void* element, const char* name, size_t* length)
+	{
+		auto attr = toElement(element)->GetAttribute(name);
+		if (attr == nullptr)
+			return nullptr;
+		return returnString(attr->Get<Rml::String>(), length);
+	}
+
+	int rmlsollua_element_has_attribute(void* element, const char* name)
+	{
+		return toElement(element)->HasAttribute(name) ? 1 : 0;
+	}
+
+	void rmlsollua_element_remove_attribute(void* element, const char* name)
+	{
+		toElement(element)->RemoveAttribute(name);
+	}
+
+	int rmlsollua_element_set_property(void* element, const char* name, const char* value)
+	{
+		return toElement(element)->SetProperty(name, value) ? 1 : 0;
+	}
+
+	const char* rmlsollua_element_get_property(void* element, const char* name, size_t* length)
+	{
+		auto property = toElement(element)->GetProperty(name);
+		if (property == nullptr)
+			return nullptr;
+		return returnString(property->ToString(), length);
+	}
+
+	void rmlsollua_element_remove_property(void* element, const char* name)
+	{
+		toElement(element)->RemoveProperty(name);
+	}
+
+	void rmlsollua_element_set_inner_rml(void* element, const char* rml)
+	{
+		toElement(element)->SetInnerRML(rml);
+	}
+
+	const char* rmlsollua_element_get_inner_rml(void* element, size_t* length)
+	{
+		return returnString(toElement(element)->GetInnerRML(), length);
+	}
+
+	void rmlsollua_element_get_box(void* element, rmlsollua_box* box)
+	{
+		auto e = toElement(element);
+		*box = rmlsollua_box{
+			e->GetOffsetLeft(), e->GetOffsetTop(), e->GetOffsetWidth(), e->GetOffsetHeight(),
+			e->GetClientLeft(), e->GetClientTop(), e->GetClientWidth(), e->GetClientHeight(),
+			e->GetScrollLeft(), e->GetScrollTop(), e->GetScrollWidth(), e->GetScrollHeight(),
+			e->GetAbsoluteLeft(), e->GetAbsoluteTop()
+		};
+	}
+
+}
+
+#endif // RMLSOLLUA_FFI
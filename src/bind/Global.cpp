@@ -1,5 +1,16 @@
 #include "bind.h"
 
+#include "plugin/SolLuaAllocator.h"
+#include "plugin/SolLuaErrors.h"
+#include "plugin/SolLuaGarbageCollector.h"
+#include "plugin/SolLuaLatency.h"
+#include "plugin/SolLuaProfiler.h"
+#include "plugin/SolLuaRecorder.h"
+#include "plugin/SolLuaStats.h"
+#include "plugin/SolLuaTrace.h"
+
+#include <iterator>
+
 
 namespace Rml::SolLua
 {
@@ -38,13 +49,428 @@ namespace Rml::SolLua
 			return Rml::RegisterEventType(type, interruptible, bubbles, default_action_phase);
 		}
 
+		auto registerEventType5(const Rml::String& type, bool interruptible, bool bubbles, Rml::DefaultActionPhase default_action_phase, sol::table parameters)
+		{
+			auto id = Rml::RegisterEventType(type, interruptible, bubbles, default_action_phase);
+
+			Rml::StringList names;
+			for (std::size_t i = 1; i <= parameters.size(); ++i)
+			{
+				if (auto name = parameters.raw_get<sol::optional<Rml::String>>(i); name)
+					names.push_back(*name);
+			}
+			setEventLayout(id, names);
+
+			return id;
+		}
+
 		auto registerEventType3(const Rml::String& type, bool interruptible, bool bubbles)
 		{
 			return Rml::RegisterEventType(type, interruptible, bubbles, Rml::DefaultActionPhase::None);
 		}
+
+		/// <summary>
+		/// Returns the box metrics of every element in a list, in the same order.
+		/// </summary>
+		/// <param name="elements">Array of elements.</param>
+		/// <param name="out">Optional array of tables to fill instead of creating new ones.  Entries past the element count are cleared.</param>
+		/// <param name="s">Lua state.</param>
+		/// <returns>Array of box tables, as returned by Element:GetBox(), with false where the element is missing.</returns>
+		sol::table getBoxes(sol::table elements, sol::optional<sol::table> out, sol::this_state s)
+		{
+			sol::state_view lua{ s };
+			const auto count = elements.size();
+			sol::table result = out ? *out : lua.create_table(static_cast<int>(count), 0);
+
+			for (std::size_t i = 1; i <= count; ++i)
+			{
+				auto element = elements.raw_get<Rml::Element*>(i);
+				if (element == nullptr)
+				{
+					// Keeps out[i] lined up with elements[i].
+					result.raw_set(i, false);
+					continue;
+				}
+
+				auto box = result.raw_get<sol::optional<sol::table>>(i);
+				if (!box)
+				{
+					box = lua.create_table(0, 14);
+					result.raw_set(i, *box);
+				}
+				fillBoxTable(*element, *box);
+			}
+
+			// A reused table may hold boxes from a longer list.
+			for (auto i = count + 1; result.raw_get<sol::object>(i).valid(); ++i)
+				result.raw_set(i, sol::lua_nil);
+
+			return result;
+		}
+
+		/// <summary>
+		/// Returns the memory tracked by the allocator installed with InstallTrackedAllocator.
+		/// </summary>
+		/// <param name="s">Lua state.</param>
+		/// <returns>Table of totals with a 'documents' array, or nil if the allocator isn't installed.</returns>
+		sol::object memoryStats(sol::this_state s)
+		{
+			sol::state_view lua{ s };
+			auto allocator = SolLuaAllocator::Get(s);
+			if (allocator == nullptr)
+				return sol::make_object(lua, sol::lua_nil);
+
+			// Copied, as building the tables allocates and may add entries.
+			const auto total = allocator->GetTotal();
+			const auto stats = allocator->GetStats();
+			const auto pooled = allocator->GetPooledBytes();
+
+			auto documents = lua.create_table(static_cast<int>(stats.size()), 0);
+			for (std::size_t i = 0; i < stats.size(); ++i)
+			{
+				const auto& entry = stats[i];
+				auto document = lua.create_table(0, 5);
+				document.raw_set(
+					"name", i == 0 ? Rml::String("(global)") : entry.Name,
+					"current", entry.Current,
+					"peak", entry.Peak,
+					"allocations", entry.Allocations,
+					"released", entry.Released
+				);
+				documents.raw_set(i + 1, document);
+			}
+
+			auto result = lua.create_table(0, 5);
+			result.raw_set(
+				"current", total.Current,
+				"peak", total.Peak,
+				"allocations", total.Allocations,
+				"pooled", pooled,
+				"documents", documents
+			);
+			return result;
+		}
+
+		/// <summary>
+		/// Returns the pause statistics of managed garbage collection.
+		/// </summary>
+		/// <param name="s">Lua state.</param>
+		/// <returns>Table of statistics, or nil if managed collection is off.</returns>
+		sol::object gcStats(sol::this_state s)
+		{
+			sol::state_view lua{ s };
+			auto collector = SolLuaGarbageCollector::Get(s);
+			if (collector == nullptr)
+				return sol::make_object(lua, sol::lua_nil);
+
+			const auto& stats = collector->GetStats();
+			auto result = lua.create_table(0, 10);
+			result.raw_set(
+				"budget_ms", collector->GetBudget(),
+				"frames", stats.Frames,
+				"steps", stats.Steps,
+				"cycles", stats.Cycles,
+				"full_collections", stats.FullCollections,
+				"last_pause_ms", stats.LastPauseMs,
+				"max_pause_ms", stats.MaxPauseMs,
+				"total_pause_ms", stats.TotalPauseMs,
+				"step_size_kb", stats.StepSizeKB,
+				"memory_kb", stats.MemoryKB
+			);
+			return result;
+		}
+
+		/// <summary>
+		/// Returns the recorded latency of every Lua entry point, slowest total first.
+		/// </summary>
+		/// <param name="s">Lua state.</param>
+		/// <returns>Array of stats tables.  Empty unless latency tracking is enabled.</returns>
+		sol::table latencyStats(sol::this_state s)
+		{
+			sol::state_view lua{ s };
+			const auto stats = SolLuaLatency::GetStats();
+
+			auto result = lua.create_table(static_cast<int>(stats.size()), 0);
+			for (std::size_t i = 0; i < stats.size(); ++i)
+			{
+				const auto& entry = stats[i];
+
+				auto buckets = lua.create_table(LatencyStats::BucketCount, 0);
+				for (int b = 0; b < LatencyStats::BucketCount; ++b)
+					buckets.raw_set(b + 1, entry.Buckets[b]);
+
+				auto table = lua.create_table(0, 9);
+				table.raw_set(
+					"label", entry.Label,
+					"count", entry.Count,
+					"slow", entry.Slow,
+					"total_ms", entry.TotalMs,
+					"mean_ms", entry.Count != 0 ? entry.TotalMs / static_cast<double>(entry.Count) : 0.0,
+					"max_ms", entry.MaxMs,
+					"p50_ms", entry.GetPercentileMs(0.5),
+					"p95_ms", entry.GetPercentileMs(0.95),
+					"buckets", buckets
+				);
+				result.raw_set(i + 1, table);
+			}
+			return result;
+		}
+
+		/// <summary>
+		/// Returns the counts of every place that raised errors, most frequent first.
+		/// </summary>
+		/// <param name="s">Lua state.</param>
+		/// <returns>Array of stats tables.</returns>
+		sol::table errorStats(sol::this_state s)
+		{
+			sol::state_view lua{ s };
+			const auto stats = SolLuaErrors::GetStats();
+
+			auto result = lua.create_table(static_cast<int>(stats.size()), 0);
+			for (std::size_t i = 0; i < stats.size(); ++i)
+			{
+				const auto& entry = stats[i];
+				auto table = lua.create_table(0, 5);
+				table.raw_set(
+					"key", entry.Key,
+					"count", entry.Count,
+					"suppressed", entry.Suppressed,
+					"first_message", entry.FirstMessage,
+					"last_message", entry.LastMessage
+				);
+				result.raw_set(i + 1, table);
+			}
+			return result;
+		}
+
+		/// <summary>
+		/// Returns the runtime counters of the library.
+		/// </summary>
+		/// <param name="s">Lua state.</param>
+		/// <returns>Table of counters, with frame, last_frame and total tables of call counts.</returns>
+		sol::table stats(sol::this_state s)
+		{
+			sol::state_view lua{ s };
+			const auto stats = SolLuaStats::Collect(s);
+
+			auto calls = [&lua](const RuntimeStats::Calls& counts) {
+				auto table = lua.create_table(0, 4);
+				table.raw_set(
+					"scripts", counts.Scripts,
+					"listeners", counts.Listeners,
+					"data_events", counts.DataEvents,
+					"data_model", counts.DataModel
+				);
+				return table;
+			};
+
+			auto result = lua.create_table(0, 9);
+			result.raw_set(
+				"listeners", stats.Listeners,
+				"compiled_listeners", stats.CompiledListeners,
+				"documents", stats.Documents,
+				"data_models", stats.DataModels,
+				"data_model_objects", stats.DataModelObjects,
+				"lua_heap_kb", stats.LuaHeapKB,
+				"frame", calls(stats.Frame),
+				"last_frame", calls(stats.LastFrame),
+				"total", calls(stats.Total)
+			);
+			return result;
+		}
 	}
 
-	#define _ENUM(N) lua["RmlKeyIdentifier"][#N] = Rml::Input::KI_##N
+	#define _ENUM(N) { #N, Rml::Input::KI_##N }
+
+	namespace keys
+	{
+		struct KeyIdentifierName
+		{
+			const char* name;
+			Rml::Input::KeyIdentifier value;
+		};
+
+		// Built into RmlKeyIdentifier with one preallocated table and raw sets.
+		const KeyIdentifierName KeyIdentifiers[] = {
+			_ENUM(UNKNOWN),
+			_ENUM(SPACE),
+			_ENUM(0),
+			_ENUM(1),
+			_ENUM(2),
+			_ENUM(3),
+			_ENUM(4),
+			_ENUM(5),
+			_ENUM(6),
+			_ENUM(7),
+			_ENUM(8),
+			_ENUM(9),
+			_ENUM(A),
+			_ENUM(B),
+			_ENUM(C),
+			_ENUM(D),
+			_ENUM(E),
+			_ENUM(F),
+			_ENUM(G),
+			_ENUM(H),
+			_ENUM(I),
+			_ENUM(J),
+			_ENUM(K),
+			_ENUM(L),
+			_ENUM(M),
+			_ENUM(N),
+			_ENUM(O),
+			_ENUM(P),
+			_ENUM(Q),
+			_ENUM(R),
+			_ENUM(S),
+			_ENUM(T),
+			_ENUM(U),
+			_ENUM(V),
+			_ENUM(W),
+			_ENUM(X),
+			_ENUM(Y),
+			_ENUM(Z),
+			_ENUM(OEM_1),
+			_ENUM(OEM_PLUS),
+			_ENUM(OEM_COMMA),
+			_ENUM(OEM_MINUS),
+			_ENUM(OEM_PERIOD),
+			_ENUM(OEM_2),
+			_ENUM(OEM_3),
+			_ENUM(OEM_4),
+			_ENUM(OEM_5),
+			_ENUM(OEM_6),
+			_ENUM(OEM_7),
+			_ENUM(OEM_8),
+			_ENUM(OEM_102),
+			_ENUM(NUMPAD0),
+			_ENUM(NUMPAD1),
+			_ENUM(NUMPAD2),
+			_ENUM(NUMPAD3),
+			_ENUM(NUMPAD4),
+			_ENUM(NUMPAD5),
+			_ENUM(NUMPAD6),
+			_ENUM(NUMPAD7),
+			_ENUM(NUMPAD8),
+			_ENUM(NUMPAD9),
+			_ENUM(NUMPADENTER),
+			_ENUM(MULTIPLY),
+			_ENUM(ADD),
+			_ENUM(SEPARATOR),
+			_ENUM(SUBTRACT),
+			_ENUM(DECIMAL),
+			_ENUM(DIVIDE),
+			_ENUM(OEM_NEC_EQUAL),
+			_ENUM(BACK),
+			_ENUM(TAB),
+			_ENUM(CLEAR),
+			_ENUM(RETURN),
+			_ENUM(PAUSE),
+			_ENUM(CAPITAL),
+			_ENUM(KANA),
+			_ENUM(HANGUL),
+			_ENUM(JUNJA),
+			_ENUM(FINAL),
+			_ENUM(HANJA),
+			_ENUM(KANJI),
+			_ENUM(ESCAPE),
+			_ENUM(CONVERT),
+			_ENUM(NONCONVERT),
+			_ENUM(ACCEPT),
+			_ENUM(MODECHANGE),
+			_ENUM(PRIOR),
+			_ENUM(NEXT),
+			_ENUM(END),
+			_ENUM(HOME),
+			_ENUM(LEFT),
+			_ENUM(UP),
+			_ENUM(RIGHT),
+			_ENUM(DOWN),
+			_ENUM(SELECT),
+			_ENUM(PRINT),
+			_ENUM(EXECUTE),
+			_ENUM(SNAPSHOT),
+			_ENUM(INSERT),
+			_ENUM(DELETE),
+			_ENUM(HELP),
+			_ENUM(LWIN),
+			_ENUM(RWIN),
+			_ENUM(APPS),
+			_ENUM(POWER),
+			_ENUM(SLEEP),
+			_ENUM(WAKE),
+			_ENUM(F1),
+			_ENUM(F2),
+			_ENUM(F3),
+			_ENUM(F4),
+			_ENUM(F5),
+			_ENUM(F6),
+			_ENUM(F7),
+			_ENUM(F8),
+			_ENUM(F9),
+			_ENUM(F10),
+			_ENUM(F11),
+			_ENUM(F12),
+			_ENUM(F13),
+			_ENUM(F14),
+			_ENUM(F15),
+			_ENUM(F16),
+			_ENUM(F17),
+			_ENUM(F18),
+			_ENUM(F19),
+			_ENUM(F20),
+			_ENUM(F21),
+			_ENUM(F22),
+			_ENUM(F23),
+			_ENUM(F24),
+			_ENUM(NUMLOCK),
+			_ENUM(SCROLL),
+			_ENUM(OEM_FJ_JISHO),
+			_ENUM(OEM_FJ_MASSHOU),
+			_ENUM(OEM_FJ_TOUROKU),
+			_ENUM(OEM_FJ_LOYA),
+			_ENUM(OEM_FJ_ROYA),
+			_ENUM(LSHIFT),
+			_ENUM(RSHIFT),
+			_ENUM(LCONTROL),
+			_ENUM(RCONTROL),
+			_ENUM(LMENU),
+			_ENUM(RMENU),
+			_ENUM(BROWSER_BACK),
+			_ENUM(BROWSER_FORWARD),
+			_ENUM(BROWSER_REFRESH),
+			_ENUM(BROWSER_STOP),
+			_ENUM(BROWSER_SEARCH),
+			_ENUM(BROWSER_FAVORITES),
+			_ENUM(BROWSER_HOME),
+			_ENUM(VOLUME_MUTE),
+			_ENUM(VOLUME_DOWN),
+			_ENUM(VOLUME_UP),
+			_ENUM(MEDIA_NEXT_TRACK),
+			_ENUM(MEDIA_PREV_TRACK),
+			_ENUM(MEDIA_STOP),
+			_ENUM(MEDIA_PLAY_PAUSE),
+			_ENUM(LAUNCH_MAIL),
+			_ENUM(LAUNCH_MEDIA_SELECT),
+			_ENUM(LAUNCH_APP1),
+			_ENUM(LAUNCH_APP2),
+			_ENUM(OEM_AX),
+			_ENUM(ICO_HELP),
+			_ENUM(ICO_00),
+			_ENUM(PROCESSKEY),
+			_ENUM(ICO_CLEAR),
+			_ENUM(ATTN),
+			_ENUM(CRSEL),
+			_ENUM(EXSEL),
+			_ENUM(EREOF),
+			_ENUM(PLAY),
+			_ENUM(ZOOM),
+			_ENUM(PA1),
+			_ENUM(OEM_CLEAR),
+		};
+	}
+
+	#undef _ENUM
 
 	void bind_global(sol::state_view& lua)
 	{
@@ -52,182 +478,10 @@ namespace Rml::SolLua
 		// We can't make this into an enum.
 		// The compiler can't handle everything under one call.
 		//lua.new_enum("RmlKeyIdentifier");
-		lua.create_named_table("RmlKeyIdentifier");
-		_ENUM(UNKNOWN);
-		_ENUM(SPACE);
-		_ENUM(0);
-		_ENUM(1);
-		_ENUM(2);
-		_ENUM(3);
-		_ENUM(4);
-		_ENUM(5);
-		_ENUM(6);
-		_ENUM(7);
-		_ENUM(8);
-		_ENUM(9);
-		_ENUM(A);
-		_ENUM(B);
-		_ENUM(C);
-		_ENUM(D);
-		_ENUM(E);
-		_ENUM(F);
-		_ENUM(G);
-		_ENUM(H);
-		_ENUM(I);
-		_ENUM(J);
-		_ENUM(K);
-		_ENUM(L);
-		_ENUM(M);
-		_ENUM(N);
-		_ENUM(O);
-		_ENUM(P);
-		_ENUM(Q);
-		_ENUM(R);
-		_ENUM(S);
-		_ENUM(T);
-		_ENUM(U);
-		_ENUM(V);
-		_ENUM(W);
-		_ENUM(X);
-		_ENUM(Y);
-		_ENUM(Z);
-		_ENUM(OEM_1);
-		_ENUM(OEM_PLUS);
-		_ENUM(OEM_COMMA);
-		_ENUM(OEM_MINUS);
-		_ENUM(OEM_PERIOD);
-		_ENUM(OEM_2);
-		_ENUM(OEM_3);
-		_ENUM(OEM_4);
-		_ENUM(OEM_5);
-		_ENUM(OEM_6);
-		_ENUM(OEM_7);
-		_ENUM(OEM_8);
-		_ENUM(OEM_102);
-		_ENUM(NUMPAD0);
-		_ENUM(NUMPAD1);
-		_ENUM(NUMPAD2);
-		_ENUM(NUMPAD3);
-		_ENUM(NUMPAD4);
-		_ENUM(NUMPAD5);
-		_ENUM(NUMPAD6);
-		_ENUM(NUMPAD7);
-		_ENUM(NUMPAD8);
-		_ENUM(NUMPAD9);
-		_ENUM(NUMPADENTER);
-		_ENUM(MULTIPLY);
-		_ENUM(ADD);
-		_ENUM(SEPARATOR);
-		_ENUM(SUBTRACT);
-		_ENUM(DECIMAL);
-		_ENUM(DIVIDE);
-		_ENUM(OEM_NEC_EQUAL);
-		_ENUM(BACK);
-		_ENUM(TAB);
-		_ENUM(CLEAR);
-		_ENUM(RETURN);
-		_ENUM(PAUSE);
-		_ENUM(CAPITAL);
-		_ENUM(KANA);
-		_ENUM(HANGUL);
-		_ENUM(JUNJA);
-		_ENUM(FINAL);
-		_ENUM(HANJA);
-		_ENUM(KANJI);
-		_ENUM(ESCAPE);
-		_ENUM(CONVERT);
-		_ENUM(NONCONVERT);
-		_ENUM(ACCEPT);
-		_ENUM(MODECHANGE);
-		_ENUM(PRIOR);
-		_ENUM(NEXT);
-		_ENUM(END);
-		_ENUM(HOME);
-		_ENUM(LEFT);
-		_ENUM(UP);
-		_ENUM(RIGHT);
-		_ENUM(DOWN);
-		_ENUM(SELECT);
-		_ENUM(PRINT);
-		_ENUM(EXECUTE);
-		_ENUM(SNAPSHOT);
-		_ENUM(INSERT);
-		_ENUM(DELETE);
-		_ENUM(HELP);
-		_ENUM(LWIN);
-		_ENUM(RWIN);
-		_ENUM(APPS);
-		_ENUM(POWER);
-		_ENUM(SLEEP);
-		_ENUM(WAKE);
-		_ENUM(F1);
-		_ENUM(F2);
-		_ENUM(F3);
-		_ENUM(F4);
-		_ENUM(F5);
-		_ENUM(F6);
-		_ENUM(F7);
-		_ENUM(F8);
-		_ENUM(F9);
-		_ENUM(F10);
-		_ENUM(F11);
-		_ENUM(F12);
-		_ENUM(F13);
-		_ENUM(F14);
-		_ENUM(F15);
-		_ENUM(F16);
-		_ENUM(F17);
-		_ENUM(F18);
-		_ENUM(F19);
-		_ENUM(F20);
-		_ENUM(F21);
-		_ENUM(F22);
-		_ENUM(F23);
-		_ENUM(F24);
-		_ENUM(NUMLOCK);
-		_ENUM(SCROLL);
-		_ENUM(OEM_FJ_JISHO);
-		_ENUM(OEM_FJ_MASSHOU);
-		_ENUM(OEM_FJ_TOUROKU);
-		_ENUM(OEM_FJ_LOYA);
-		_ENUM(OEM_FJ_ROYA);
-		_ENUM(LSHIFT);
-		_ENUM(RSHIFT);
-		_ENUM(LCONTROL);
-		_ENUM(RCONTROL);
-		_ENUM(LMENU);
-		_ENUM(RMENU);
-		_ENUM(BROWSER_BACK);
-		_ENUM(BROWSER_FORWARD);
-		_ENUM(BROWSER_REFRESH);
-		_ENUM(BROWSER_STOP);
-		_ENUM(BROWSER_SEARCH);
-		_ENUM(BROWSER_FAVORITES);
-		_ENUM(BROWSER_HOME);
-		_ENUM(VOLUME_MUTE);
-		_ENUM(VOLUME_DOWN);
-		_ENUM(VOLUME_UP);
-		_ENUM(MEDIA_NEXT_TRACK);
-		_ENUM(MEDIA_PREV_TRACK);
-		_ENUM(MEDIA_STOP);
-		_ENUM(MEDIA_PLAY_PAUSE);
-		_ENUM(LAUNCH_MAIL);
-		_ENUM(LAUNCH_MEDIA_SELECT);
-		_ENUM(LAUNCH_APP1);
-		_ENUM(LAUNCH_APP2);
-		_ENUM(OEM_AX);
-		_ENUM(ICO_HELP);
-		_ENUM(ICO_00);
-		_ENUM(PROCESSKEY);
-		_ENUM(ICO_CLEAR);
-		_ENUM(ATTN);
-		_ENUM(CRSEL);
-		_ENUM(EXSEL);
-		_ENUM(EREOF);
-		_ENUM(PLAY);
-		_ENUM(ZOOM);
-		_ENUM(PA1);
-		_ENUM(OEM_CLEAR);
+		auto keyIdentifier = lua.create_table(0, static_cast<int>(std::size(keys::KeyIdentifiers)));
+		for (const auto& key : keys::KeyIdentifiers)
+			keyIdentifier.raw_set(key.name, key.value);
+		lua["RmlKeyIdentifier"] = keyIdentifier;
 
 		lua.new_enum<Rml::Input::KeyModifier>("RmlKeyModifier", {
 			{ "CTRL", Rml::Input::KM_CTRL },
@@ -265,21 +519,34 @@ namespace Rml::SolLua
 			//"RegisterTag",
 			//--
 			"GetContext", sol::resolve<Rml::Context* (const Rml::String&)>(&Rml::GetContext),
-			"RegisterEventType", sol::overload(&functions::registerEventType4, &functions::registerEventType3),
+			"RegisterEventType", sol::overload(&functions::registerEventType5, &functions::registerEventType4, &functions::registerEventType3),
+			"GetBoxes", &functions::getBoxes,
+			"MemoryStats", &functions::memoryStats,
+			"GCStats", &functions::gcStats,
+			"LatencyStats", &functions::latencyStats,
+			"DumpTrace", &SolLuaTrace::Dump,
+			"StartProfiler", [](sol::optional<int> hz, sol::this_state s) { SolLuaProfiler::Start(sol::main_thread(s, s), hz.value_or(1000)); },
+			"StopProfiler", &SolLuaProfiler::Stop,
+			"Stats", &functions::stats,
+			"ResetFrameStats", &SolLuaStats::ResetFrame,
+			"ErrorStats", &functions::errorStats,
+			"StartRecording", &SolLuaRecorder::Start,
+			"StopRecording", &SolLuaRecorder::Stop,
 
 			// G
 			"contexts", sol::readonly_property(&getIndexedTable<Rml::Context, &functions::getContext, &functions::getMaxContexts>),
 			//--
 			"version", sol::readonly_property(&Rml::GetVersion)
 		);
-		g.set("key_identifier", sol::readonly_property([&lua] { return lua["RmlKeyIdentifier"]; }));
-		g.set("key_modifier", sol::readonly_property([&lua] { return lua["RmlKeyModifier"]; }));
+		g.set("key_identifier", sol::readonly_property([](sol::this_state s) -> sol::object { return sol::state_view{ s }["RmlKeyIdentifier"]; }));
+		g.set("key_modifier", sol::readonly_property([](sol::this_state s) -> sol::object { return sol::state_view{ s }["RmlKeyModifier"]; }));
 		//--
-		g.set("font_weight", sol::readonly_property([&lua] { return lua["RmlFontWeight"]; }));
-		g.set("default_action_phase", sol::readonly_property([&lua] { return lua["RmlDefaultActionPhase"]; }));
+		g.set("font_weight", sol::readonly_property([](sol::this_state s) -> sol::object { return sol::state_view{ s }["RmlFontWeight"]; }));
+		g.set("default_action_phase", sol::readonly_property([](sol::this_state s) -> sol::object { return sol::state_view{ s }["RmlDefaultActionPhase"]; }));
+		//--
+		g.set("vec2", sol::readonly_property([](sol::this_state s) -> sol::object { return sol::state_view{ s }["RmlVec2"]; }));
+		g.set("colour", sol::readonly_property([](sol::this_state s) -> sol::object { return sol::state_view{ s }["RmlColour"]; }));
 
 	}
 
-	#undef _ENUM
-
 } // end namespace Rml::SolLua
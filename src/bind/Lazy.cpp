@@ -0,0 +1,241 @@
+#include "bind.h"
+
+
+namespace Rml::SolLua
+{
+
+	namespace lazy
+	{
+		enum class Group
+		{
+			Core,
+			Derived,
+			Form,
+			Convert,
+			Global,
+			Log,
+			Count
+		};
+
+		// Registry table holding one flag per registered group, and the globals metatable installed by bind_lazy.
+		constexpr const char* RegistryKey = "RmlSolLua.lazy";
+		constexpr const char* HookKey = "hook";
+		constexpr const char* ConvertKey = "as";
+
+		// Global names that install their group the first time they are read.
+		const Rml::UnorderedMap<Rml::String, Group>& getTriggers()
+		{
+			static const Rml::UnorderedMap<Rml::String, Group> triggers = {
+				{ "Colourb", Group::Core },
+				{ "Colourf", Group::Core },
+				{ "RmlColour", Group::Core },
+				{ "Context", Group::Core },
+				{ "SolLuaDataModel", Group::Core },
+				{ "EventListener", Group::Core },
+				{ "StyleProxy", Group::Core },
+				{ "Document", Group::Core },
+				{ "RmlModalFlag", Group::Core },
+				{ "RmlFocusFlag", Group::Core },
+				{ "Event", Group::Core },
+				{ "RmlEventPhase", Group::Core },
+				{ "Vector2i", Group::Core },
+				{ "Vector2f", Group::Core },
+				{ "RmlVec2", Group::Core },
+				{ "ElementText", Group::Derived },
+				{ "ElementDataGrid", Group::Derived },
+				{ "ElementDataGridRow", Group::Derived },
+				{ "ElementDataGridCell", Group::Derived },
+				{ "ElementTabSet", Group::Derived },
+				{ "ElementProgress", Group::Derived },
+				{ "ElementForm", Group::Form },
+				{ "ElementFormControl", Group::Form },
+				{ "ElementFormControlInput", Group::Form },
+				{ "ElementFormControlSelect", Group::Form },
+				{ "ElementFormControlDataSelect", Group::Form },
+				{ "ElementFormControlTextArea", Group::Form },
+				{ "Element", Group::Core },
+				{ "rmlui", Group::Global },
+				{ "RmlKeyIdentifier", Group::Global },
+				{ "RmlKeyModifier", Group::Global },
+				{ "RmlFontWeight", Group::Global },
+				{ "RmlDefaultActionPhase", Group::Global },
+				{ "Log", Group::Log },
+				{ "RmlLogType", Group::Log }
+			};
+			return triggers;
+		}
+
+		sol::table getFlags(sol::state_view& lua)
+		{
+			auto registry = lua.registry();
+			auto flags = registry.raw_get<sol::optional<sol::table>>(RegistryKey);
+			if (!flags)
+			{
+				flags = lua.create_table(static_cast<int>(Group::Count), 1);
+				registry.raw_set(RegistryKey, *flags);
+			}
+			return *flags;
+		}
+
+		bool isRegistered(sol::table& flags, Group group)
+		{
+			return flags.raw_get_or(static_cast<int>(group) + 1, false);
+		}
+
+		bool isComplete(sol::table& flags)
+		{
+			for (int group = 0; group < static_cast<int>(Group::Count); ++group)
+			{
+				if (!isRegistered(flags, static_cast<Group>(group)))
+					return false;
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// Removes the globals metatable installed by bind_lazy.  A metatable the host set since then is left alone.
+		/// </summary>
+		void removeHook(sol::state_view& lua, sol::table& flags)
+		{
+			auto hook = flags.raw_get<sol::object>(HookKey);
+			if (!hook.valid())
+				return;
+
+			lua_State* L = lua.lua_state();
+			auto globals = lua.globals();
+			sol::object metatable = globals[sol::metatable_key];
+			hook.push(L);
+			metatable.push(L);
+			const bool ours = lua_rawequal(L, -1, -2) != 0;
+			lua_pop(L, 2);
+
+			if (ours)
+				globals[sol::metatable_key] = sol::lua_nil;
+			flags.raw_set(HookKey, sol::lua_nil);
+		}
+
+		sol::object convertIndex(sol::table element_as, sol::stack_object key, sol::this_state s);
+
+		void registerGroup(sol::state_view& lua, Group group)
+		{
+			auto flags = getFlags(lua);
+			if (isRegistered(flags, group))
+				return;
+
+			// Flag first so lookups made while registering don't recurse.
+			flags.raw_set(static_cast<int>(group) + 1, true);
+
+			switch (group)
+			{
+			case Group::Core:
+				// Elements, documents, contexts and events return each other, and Variants hold colours and vectors,
+				// so these are always installed together.
+				bind_color(lua);
+				bind_vector(lua);
+				bind_context(lua);
+				bind_datamodel(lua);
+				bind_element(lua);
+				bind_document(lua);
+				bind_event(lua);
+#ifdef RMLSOLLUA_FFI
+				bind_ffi(lua);
+#endif
+				{
+					// Element.As fills in the first time it is read, as its conversions return derived and form usertypes.
+					auto element_as = bind_convert(lua);
+					auto metatable = lua.create_table(0, 1);
+					metatable.raw_set(sol::meta_function::index, &convertIndex);
+					element_as[sol::metatable_key] = metatable;
+					flags.raw_set(ConvertKey, element_as);
+				}
+				break;
+			case Group::Derived:
+				// Each derived usertype copies the Element members, so they only cost when used.
+				registerGroup(lua, Group::Core);
+				bind_element_derived(lua);
+				break;
+			case Group::Form:
+				registerGroup(lua, Group::Core);
+				bind_element_form(lua);
+				break;
+			case Group::Convert:
+				// Element.As returns every derived type.
+				registerGroup(lua, Group::Core);
+				registerGroup(lua, Group::Derived);
+				registerGroup(lua, Group::Form);
+				if (auto element_as = flags.raw_get<sol::optional<sol::table>>(ConvertKey); element_as)
+				{
+					bind_convert_as(*element_as);
+					(*element_as)[sol::metatable_key] = sol::lua_nil;
+					flags.raw_set(ConvertKey, sol::lua_nil);
+				}
+				break;
+			case Group::Global:
+				// rmlui returns contexts.
+				registerGroup(lua, Group::Core);
+				bind_global(lua);
+				break;
+			case Group::Log:
+				bind_log(lua);
+				break;
+			case Group::Count:
+				break;
+			}
+
+			// Drop the globals hook once everything is installed.
+			if (isComplete(flags))
+				removeHook(lua, flags);
+		}
+
+		sol::object convertIndex(sol::table element_as, sol::stack_object key, sol::this_state s)
+		{
+			sol::state_view lua{ s };
+			registerGroup(lua, Group::Convert);
+			return element_as.raw_get<sol::object>(key);
+		}
+
+		sol::object index(sol::table globals, sol::stack_object key, sol::this_state s)
+		{
+			if (key.get_type() != sol::type::string)
+				return sol::make_object(s, sol::lua_nil);
+
+			const auto& triggers = getTriggers();
+			auto it = triggers.find(key.as<Rml::String>());
+			if (it == triggers.end())
+				return sol::make_object(s, sol::lua_nil);
+
+			sol::state_view lua{ s };
+			registerGroup(lua, it->second);
+			return globals.raw_get<sol::object>(key);
+		}
+	}
+
+	void bind_lazy(sol::state_view& lua)
+	{
+		auto globals = lua.globals();
+
+		// Can't chain onto a globals metatable set by the host, so register everything up front instead.
+		if (globals[sol::metatable_key].get_type() != sol::type::lua_nil)
+		{
+			ensureRegistered(lua);
+			return;
+		}
+
+		auto metatable = lua.create_table(0, 1);
+		metatable.raw_set(sol::meta_function::index, &lazy::index);
+		globals[sol::metatable_key] = metatable;
+		lazy::getFlags(lua).raw_set(lazy::HookKey, metatable);
+	}
+
+	void ensureRegistered(sol::state_view& lua)
+	{
+		for (int group = 0; group < static_cast<int>(lazy::Group::Count); ++group)
+			lazy::registerGroup(lua, static_cast<lazy::Group>(group));
+	}
+
+	void ensureCoreRegistered(sol::state_view& lua)
+	{
+		lazy::registerGroup(lua, lazy::Group::Core);
+	}
+
+} // end namespace Rml::SolLua
@@ -1,5 +1,7 @@
 #include "bind.h"
 
+#include "plugin/SolLuaLog.h"
+
 
 namespace Rml::SolLua
 {
@@ -20,16 +22,13 @@ namespace Rml::SolLua
 		// Log.Message(Log.logtype.error, "This is an error.")
 		auto log = lua.create_named_table("Log");
 		log["logtype"] = lua["RmlLogType"];
-		log.set_function("Message", [](Rml::Log::Type type, const std::string& message) { Log::Message(type, "%s", message.c_str()); });
+		log["Message"] = &SolLuaLog::Message;
+		//--
+		log["SetLevel"] = &SolLuaLog::SetLevel;
+		log["GetLevel"] = &SolLuaLog::GetLevel;
 
 		// print("Text")
-		lua["print"] = lua.script(R"(return function(...)
-			local parts = table.pack(...)
-			for i = 1, #parts do
-				parts[i] = tostring(parts[i])
-			end
-			Log.Message(Log.logtype.info, table.concat(parts, "\t"))
-		end)");
+		lua["print"] = &SolLuaLog::Print;
 	}
 
 } // end namespace Rml::SolLua
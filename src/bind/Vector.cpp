@@ -4,6 +4,42 @@
 namespace Rml::SolLua
 {
 
+	namespace vec2
+	{
+		// Unboxed 2D math.  Every function takes and returns plain numbers so no userdata is created.
+		std::tuple<float, float> add(float ax, float ay, float bx, float by) { return { ax + bx, ay + by }; }
+		std::tuple<float, float> sub(float ax, float ay, float bx, float by) { return { ax - bx, ay - by }; }
+		std::tuple<float, float> mul(float ax, float ay, float bx, float by) { return { ax * bx, ay * by }; }
+		std::tuple<float, float> scale(float x, float y, float s) { return { x * s, y * s }; }
+		float dot(float ax, float ay, float bx, float by) { return ax * bx + ay * by; }
+		float length(float x, float y) { return Rml::Vector2f(x, y).Magnitude(); }
+		float distance(float ax, float ay, float bx, float by) { return Rml::Vector2f(bx - ax, by - ay).Magnitude(); }
+
+		std::tuple<float, float> normalise(float x, float y)
+		{
+			auto n = Rml::Vector2f(x, y).Normalise();
+			return { n.x, n.y };
+		}
+
+		std::tuple<float, float> lerp(float ax, float ay, float bx, float by, float t)
+		{
+			return { ax + (bx - ax) * t, ay + (by - ay) * t };
+		}
+	}
+
+	template <typename T>
+	std::tuple<T, T> getXY(Rml::Vector2<T>& self)
+	{
+		return { self.x, self.y };
+	}
+
+	template <typename T>
+	void setXY(Rml::Vector2<T>& self, T x, T y)
+	{
+		self.x = x;
+		self.y = y;
+	}
+
 	void bind_vector(sol::state_view& lua)
 	{
 		lua.new_usertype<Rml::Vector2i>("Vector2i", sol::constructors<Rml::Vector2i(), Rml::Vector2i(int, int)>(),
@@ -29,7 +65,15 @@ namespace Rml::SolLua
 			"y", &Rml::Vector2i::y,
 
 			// G
-			"magnitude", &Rml::Vector2i::Magnitude
+			"magnitude", &Rml::Vector2i::Magnitude,
+
+			// M
+			//--
+			"Set", &setXY<int>,
+			"Unpack", &getXY<int>,
+			// Single signature versions of the overloaded operators.
+			"Scale", sol::resolve<Rml::Vector2i(int) const>(&Rml::Vector2i::operator*),
+			"Multiply", sol::resolve<Rml::Vector2i(Rml::Vector2i) const>(&Rml::Vector2i::operator*)
 		);
 
 		lua.new_usertype<Rml::Vector2f>("Vector2f", sol::constructors<Rml::Vector2f(), Rml::Vector2f(float, float)>(),
@@ -55,8 +99,28 @@ namespace Rml::SolLua
 			"y", &Rml::Vector2f::y,
 
 			// G
-			"magnitude", &Rml::Vector2f::Magnitude
+			"magnitude", &Rml::Vector2f::Magnitude,
+
+			// M
+			//--
+			"Set", &setXY<float>,
+			"Unpack", &getXY<float>,
+			// Single signature versions of the overloaded operators.
+			"Scale", sol::resolve<Rml::Vector2f(float) const>(&Rml::Vector2f::operator*),
+			"Multiply", sol::resolve<Rml::Vector2f(Rml::Vector2f) const>(&Rml::Vector2f::operator*)
 		);
+
+		//--
+		auto math = lua.create_named_table("RmlVec2");
+		math.set_function("add", &vec2::add);
+		math.set_function("sub", &vec2::sub);
+		math.set_function("mul", &vec2::mul);
+		math.set_function("scale", &vec2::scale);
+		math.set_function("dot", &vec2::dot);
+		math.set_function("length", &vec2::length);
+		math.set_function("distance", &vec2::distance);
+		math.set_function("normalise", &vec2::normalise);
+		math.set_function("lerp", &vec2::lerp);
 	}
 
 } // end namespace Rml::SolLua
@@ -1,82 +1,352 @@
 #include "bind.h"
 
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <functional>
+#include <limits>
+#include <string>
 
 
-namespace Rml::SolLua
+namespace
 {
 
-	sol::object makeObjectFromVariant(const Rml::Variant* variant, sol::state_view s)
+	int absoluteIndex(lua_State* L, int index)
 	{
-		if (!variant) return sol::make_object(s, sol::nil);
+		return (index < 0 && index > LUA_REGISTRYINDEX) ? lua_gettop(L) + index + 1 : index;
+	}
+
+	std::size_t rawLength(lua_State* L, int index)
+	{
+#if LUA_VERSION_NUM >= 502
+		return lua_rawlen(L, index);
+#else
+		return lua_objlen(L, index);
+#endif
+	}
+
+	void pushInteger(lua_State* L, int64_t value)
+	{
+#if LUA_VERSION_NUM >= 503
+		lua_pushinteger(L, static_cast<lua_Integer>(value));
+#else
+		// Lua 5.1 and LuaJIT only have one number type.
+		lua_pushnumber(L, static_cast<lua_Number>(value));
+#endif
+	}
+
+	template <typename T>
+	bool getUserdata(lua_State* L, int index, Rml::Variant& result)
+	{
+		if (!sol::stack::check<T>(L, index, &sol::no_panic))
+			return false;
 
-		switch (variant->GetType())
+		result = Rml::Variant(sol::stack::get<T>(L, index));
+		return true;
+	}
+
+} // end anonymous namespace
+
+
+namespace Rml
+{
+
+	int sol_lua_push(sol::types<Rml::Variant>, lua_State* L, const Rml::Variant& variant)
+	{
+		switch (variant.GetType())
 		{
 		case Rml::Variant::BOOL:
-			return sol::make_object(s, variant->Get<bool>());
+			lua_pushboolean(L, variant.Get<bool>());
+			break;
 		case Rml::Variant::BYTE:
 		case Rml::Variant::CHAR:
 		case Rml::Variant::INT:
-			return sol::make_object(s, variant->Get<int>());
+			pushInteger(L, variant.Get<int>());
+			break;
 		case Rml::Variant::INT64:
-			return sol::make_object(s, variant->Get<int64_t>());
+			pushInteger(L, variant.Get<int64_t>());
+			break;
 		case Rml::Variant::UINT:
-			return sol::make_object(s, variant->Get<unsigned int>());
+			pushInteger(L, variant.Get<unsigned int>());
+			break;
 		case Rml::Variant::UINT64:
-			return sol::make_object(s, variant->Get<uint64_t>());
+		{
+			const auto value = variant.Get<uint64_t>();
+			if (value <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+				pushInteger(L, static_cast<int64_t>(value));
+			else
+				lua_pushnumber(L, static_cast<lua_Number>(value));
+			break;
+		}
 		case Rml::Variant::FLOAT:
 		case Rml::Variant::DOUBLE:
-			return sol::make_object(s, variant->Get<double>());
+			lua_pushnumber(L, variant.Get<double>());
+			break;
 		case Rml::Variant::COLOURB:
-			return sol::make_object_userdata<Rml::Colourb>(s, variant->Get<Rml::Colourb>());
+			sol::stack::push_userdata<Rml::Colourb>(L, variant.Get<Rml::Colourb>());
+			break;
 		case Rml::Variant::COLOURF:
-			return sol::make_object_userdata<Rml::Colourf>(s, variant->Get<Rml::Colourf>());
+			sol::stack::push_userdata<Rml::Colourf>(L, variant.Get<Rml::Colourf>());
+			break;
 		case Rml::Variant::STRING:
-			return sol::make_object(s, variant->GetReference<Rml::String>());
+		{
+			const auto& str = variant.GetReference<Rml::String>();
+			lua_pushlstring(L, str.data(), str.size());
+			break;
+		}
 		case Rml::Variant::VECTOR2:
-			return sol::make_object_userdata<Rml::Vector2f>(s, variant->Get<Rml::Vector2f>());
+			sol::stack::push_userdata<Rml::Vector2f>(L, variant.Get<Rml::Vector2f>());
+			break;
 		case Rml::Variant::VOIDPTR:
-			return sol::make_object(s, variant->Get<void*>());
+			lua_pushlightuserdata(L, variant.Get<void*>());
+			break;
 		default:
-			return sol::make_object(s, sol::nil);
+			lua_pushnil(L);
+			break;
 		}
 
-		return sol::make_object(s, sol::nil);
+		return 1;
 	}
 
-	Rml::Variant makeVariantFromObject(const sol::object& o)
+	Rml::Variant sol_lua_get(sol::types<Rml::Variant>, lua_State* L, int index, sol::stack::record& tracking)
 	{
-		switch (o.get_type())
+		tracking.use(1);
+
+		switch (lua_type(L, index))
 		{
-		case sol::type::string:
-			return Rml::Variant(o.as<std::string>());
-		case sol::type::number:
-			return Rml::Variant(o.as<float>());
-		case sol::type::boolean:
-			return Rml::Variant(o.as<bool>());
-		case sol::type::userdata:
+		case LUA_TBOOLEAN:
+			return Rml::Variant(lua_toboolean(L, index) != 0);
+		case LUA_TNUMBER:
 		{
-			if (auto c = o.as<sol::optional<Rml::Colourb>>(); c)
-				return Rml::Variant(*c);
-			else if (auto c = o.as<sol::optional<Rml::Colourf>>(); c)
-				return Rml::Variant(*c);
-			else if (auto c = o.as<sol::optional<Rml::Colourf>>(); c)
-				return Rml::Variant(*c);
-			else if (auto c = o.as<sol::optional<Rml::Vector2f>>(); c)
-				return Rml::Variant(*c);
-			else if (auto c = o.as<sol::optional<Rml::Vector3f>>(); c)
-				return Rml::Variant(*c);
-			else if (auto c = o.as<sol::optional<Rml::Vector4f>>(); c)
-				return Rml::Variant(*c);
-			else
-				return Rml::Variant();
+#if LUA_VERSION_NUM >= 503
+			if (lua_isinteger(L, index))
+			{
+				const auto value = static_cast<int64_t>(lua_tointeger(L, index));
+				if (value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max())
+					return Rml::Variant(static_cast<int>(value));
+				return Rml::Variant(value);
+			}
+#endif
+			return Rml::Variant(static_cast<double>(lua_tonumber(L, index)));
+		}
+		case LUA_TSTRING:
+		{
+			std::size_t length = 0;
+			const char* str = lua_tolstring(L, index, &length);
+			return Rml::Variant(Rml::String(str, length));
+		}
+		case LUA_TLIGHTUSERDATA:
+			return Rml::Variant(lua_touserdata(L, index));
+		case LUA_TUSERDATA:
+		{
+			Rml::Variant result;
+			if (getUserdata<Rml::Colourb>(L, index, result)
+				|| getUserdata<Rml::Colourf>(L, index, result)
+				|| getUserdata<Rml::Vector2f>(L, index, result)
+				|| getUserdata<Rml::Vector3f>(L, index, result)
+				|| getUserdata<Rml::Vector4f>(L, index, result))
+				return result;
+			return Rml::Variant();
 		}
-		case sol::type::lightuserdata:
-			return Rml::Variant(o.as<void*>());
 		default:
 			return Rml::Variant();
 		}
 	}
 
+	int sol_lua_push(sol::types<Rml::VariantList>, lua_State* L, const Rml::VariantList& list)
+	{
+		lua_createtable(L, static_cast<int>(list.size()), 0);
+		int i = 0;
+		for (const auto& variant : list)
+		{
+			sol_lua_push(sol::types<Rml::Variant>{}, L, variant);
+			lua_rawseti(L, -2, ++i);
+		}
+		return 1;
+	}
+
+	Rml::VariantList sol_lua_get(sol::types<Rml::VariantList>, lua_State* L, int index, sol::stack::record& tracking)
+	{
+		tracking.use(1);
+		index = absoluteIndex(L, index);
+
+		Rml::VariantList result;
+		if (lua_type(L, index) != LUA_TTABLE)
+			return result;
+
+		const auto length = rawLength(L, index);
+		result.reserve(length);
+		for (std::size_t i = 1; i <= length; ++i)
+		{
+			lua_rawgeti(L, index, static_cast<int>(i));
+			sol::stack::record element_tracking{};
+			result.push_back(sol_lua_get(sol::types<Rml::Variant>{}, L, -1, element_tracking));
+			lua_pop(L, 1);
+		}
+		return result;
+	}
+
+	int sol_lua_push(sol::types<Rml::Dictionary>, lua_State* L, const Rml::Dictionary& dictionary)
+	{
+		lua_createtable(L, 0, static_cast<int>(dictionary.size()));
+		for (const auto& [key, value] : dictionary)
+		{
+			lua_pushlstring(L, key.data(), key.size());
+			sol_lua_push(sol::types<Rml::Variant>{}, L, value);
+			lua_rawset(L, -3);
+		}
+		return 1;
+	}
+
+	Rml::Dictionary sol_lua_get(sol::types<Rml::Dictionary>, lua_State* L, int index, sol::stack::record& tracking)
+	{
+		tracking.use(1);
+		index = absoluteIndex(L, index);
+
+		Rml::Dictionary result;
+		Rml::SolLua::getDictionary(L, index, result);
+		return result;
+	}
+
+} // end namespace Rml
+
+
+namespace Rml::SolLua
+{
+
+	namespace dictionary
+	{
+		// Nested tables deeper than this are ignored, which also stops reference cycles.
+		constexpr int MaxDepth = 8;
+
+		struct Reader
+		{
+			Rml::Dictionary& result;
+			Rml::String& key;
+			// Set when a number key, or a string key holding '.', could flatten to the same name as another key.
+			bool ambiguous = false;
+			// Values written.  Without duplicate names, it equals the dictionary size only if no older entry is left.
+			std::size_t written = 0;
+		};
+
+		void appendNumber(lua_State* L, int index, Rml::String& key)
+		{
+			char buffer[32];
+#if LUA_VERSION_NUM >= 503
+			if (lua_isinteger(L, index))
+			{
+				std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(lua_tointeger(L, index)));
+				key.append(buffer);
+				return;
+			}
+#endif
+			// Whole numbers keep their array index names on Lua 5.1, where every number is a double.
+			const auto value = static_cast<double>(lua_tonumber(L, index));
+			if (std::floor(value) == value && std::fabs(value) < 1e15)
+				std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+			else
+				std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+			key.append(buffer);
+		}
+
+		void readTable(lua_State* L, int index, Reader& reader, int depth)
+		{
+			auto& key = reader.key;
+			const auto prefix_length = key.size();
+
+			lua_pushnil(L);
+			while (lua_next(L, index) != 0)
+			{
+				// lua_tolstring is never called on number keys, as converting them in place would break lua_next.
+				key.resize(prefix_length);
+				bool valid = true;
+				switch (lua_type(L, -2))
+				{
+				case LUA_TSTRING:
+				{
+					std::size_t length = 0;
+					const char* name = lua_tolstring(L, -2, &length);
+					if (std::memchr(name, '.', length) != nullptr)
+						reader.ambiguous = true;
+					key.append(name, length);
+					break;
+				}
+				case LUA_TNUMBER:
+					appendNumber(L, lua_gettop(L) - 1, key);
+					reader.ambiguous = true;
+					break;
+				default:
+					valid = false;
+					break;
+				}
+
+				if (valid)
+				{
+					if (lua_type(L, -1) == LUA_TTABLE)
+					{
+						// Nested tables and arrays are flattened: { pos = { x = 1 } } becomes "pos.x", { list = { "a" } } becomes "list.1".
+						if (depth < MaxDepth)
+						{
+							key.push_back('.');
+							readTable(L, lua_gettop(L), reader, depth + 1);
+						}
+					}
+					else
+					{
+						sol::stack::record tracking{};
+						auto value = sol_lua_get(sol::types<Rml::Variant>{}, L, -1, tracking);
+
+						// Keys already in the dictionary keep their storage, so a repeated dispatch builds no key strings.
+						if (auto iter = reader.result.find(key); iter != reader.result.end())
+							iter->second = std::move(value);
+						else
+							reader.result.emplace(key, std::move(value));
+						++reader.written;
+					}
+				}
+
+				lua_pop(L, 1);
+			}
+
+			key.resize(prefix_length);
+		}
+	}
+
+	void getDictionary(lua_State* L, int index, Rml::Dictionary& result)
+	{
+		index = absoluteIndex(L, index);
+		if (lua_type(L, index) != LUA_TTABLE)
+		{
+			result.clear();
+			return;
+		}
+
+		const bool reused = !result.empty();
+		Scratch<Rml::String> key;
+		key->clear();
+		dictionary::Reader reader{ result, *key };
+		dictionary::readTable(L, index, reader, 0);
+
+		// Entries of an earlier table may be left over.  Read again into an empty dictionary unless every entry was overwritten.
+		if (reused && (reader.ambiguous || reader.written != result.size()))
+		{
+			result.clear();
+			key->clear();
+			dictionary::Reader fresh{ result, *key };
+			dictionary::readTable(L, index, fresh, 0);
+		}
+	}
+
+	sol::object makeObjectFromVariant(const Rml::Variant* variant, sol::state_view s)
+	{
+		if (!variant) return sol::make_object(s, sol::nil);
+		return sol::make_object(s, *variant);
+	}
+
+	Rml::Variant makeVariantFromObject(const sol::object& o)
+	{
+		return o.as<Rml::Variant>();
+	}
+
 
 } // end namespace Rml::SolLua
@@ -3,7 +3,9 @@
 #include <RmlUi/Core.h>
 #include <sol/sol.hpp>
 
+#include <deque>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <type_traits>
 
@@ -29,12 +31,79 @@ struct sol::is_container<Rml::ElementList> : std::true_type {};
 #endif
 
 
+// Stack customizations that convert Rml::Variant, Rml::VariantList, and Rml::Dictionary directly to and from Lua values.
+// They are found through ADL, so they live in the Rml namespace.
+namespace Rml
+{
+
+	int sol_lua_push(sol::types<Rml::Variant>, lua_State* L, const Rml::Variant& variant);
+	Rml::Variant sol_lua_get(sol::types<Rml::Variant>, lua_State* L, int index, sol::stack::record& tracking);
+
+	template <typename Handler>
+	bool sol_lua_check(sol::types<Rml::Variant>, lua_State* L, int index, Handler&& handler, sol::stack::record& tracking)
+	{
+		// Every Lua value converts to a Variant.  Unsupported types become an empty Variant.
+		tracking.use(1);
+		return true;
+	}
+
+	int sol_lua_push(sol::types<Rml::VariantList>, lua_State* L, const Rml::VariantList& list);
+	Rml::VariantList sol_lua_get(sol::types<Rml::VariantList>, lua_State* L, int index, sol::stack::record& tracking);
+
+	template <typename Handler>
+	bool sol_lua_check(sol::types<Rml::VariantList>, lua_State* L, int index, Handler&& handler, sol::stack::record& tracking)
+	{
+		tracking.use(1);
+		const auto type = lua_type(L, index);
+		if (type == LUA_TTABLE || type == LUA_TNIL || type == LUA_TNONE)
+			return true;
+
+		handler(L, index, sol::type::table, sol::type_of(L, index), "expected a table of values");
+		return false;
+	}
+
+	int sol_lua_push(sol::types<Rml::Dictionary>, lua_State* L, const Rml::Dictionary& dictionary);
+	Rml::Dictionary sol_lua_get(sol::types<Rml::Dictionary>, lua_State* L, int index, sol::stack::record& tracking);
+
+	template <typename Handler>
+	bool sol_lua_check(sol::types<Rml::Dictionary>, lua_State* L, int index, Handler&& handler, sol::stack::record& tracking)
+	{
+		tracking.use(1);
+		const auto type = lua_type(L, index);
+		if (type == LUA_TTABLE || type == LUA_TNIL || type == LUA_TNONE)
+			return true;
+
+		handler(L, index, sol::type::table, sol::type_of(L, index), "expected a table with string keys");
+		return false;
+	}
+
+} // end namespace Rml
+
+
 namespace Rml::SolLua
 {
 
 	sol::object makeObjectFromVariant(const Rml::Variant* variant, sol::state_view s);
 	Rml::Variant makeVariantFromObject(const sol::object& o);
-	using SolObjectMap = std::unordered_map<std::string, sol::object>;
+	void fillBoxTable(Rml::Element& element, sol::table& table);
+	/// <summary>
+	/// Reads a table of parameters into a dictionary, overwriting the values of keys it already holds and removing the others.
+	/// </summary>
+	void getDictionary(lua_State* L, int index, Rml::Dictionary& result);
+
+	/// <summary>
+	/// A parameter layout registered for a custom event type through rmlui.RegisterEventType.
+	/// The dictionary keys are created once; dispatching only overwrites the values in place.
+	/// </summary>
+	struct EventLayout
+	{
+		Rml::Dictionary Parameters;
+		Rml::Vector<Rml::Variant*> Values;
+	};
+
+	// Defined in Event.cpp.
+	void setEventLayout(Rml::EventId id, const Rml::StringList& names);
+	EventLayout* getEventLayout(Rml::EventId id);
 
 	inline int from_lua_index(int i) { return i - 1; }
 	inline int to_lua_index(int i) { return i + 1; }
@@ -42,6 +111,62 @@ namespace Rml::SolLua
 } // end namespace Rml::SolLua
 
 
+namespace Rml::SolLua
+{
+
+	/// <summary>
+	/// Borrows a reusable per-thread object for the duration of a binding call.
+	/// Objects are stacked by call depth, so a re-entrant call (such as a Lua listener run from inside
+	/// SetAttribute that sets another attribute) never reuses a buffer still held by its caller.
+	/// </summary>
+	/// <typeparam name="T">The type of object to borrow.  Its capacity is kept between calls.</typeparam>
+	template <typename T>
+	class Scratch
+	{
+	public:
+		Scratch()
+		{
+			auto& pool = getPool();
+			auto& depth = getDepth();
+			if (pool.size() <= depth)
+				pool.emplace_back();
+			m_value = &pool[depth++];
+		}
+
+		~Scratch()
+		{
+			--getDepth();
+		}
+
+		Scratch(const Scratch&) = delete;
+		Scratch& operator=(const Scratch&) = delete;
+
+		T& operator*() { return *m_value; }
+		T* operator->() { return m_value; }
+
+	private:
+		// std::deque never moves its elements when growing, so borrowed pointers stay valid.
+		static std::deque<T>& getPool() { thread_local std::deque<T> pool; return pool; }
+		static std::size_t& getDepth() { thread_local std::size_t depth = 0; return depth; }
+
+		T* m_value;
+	};
+
+	/// <summary>
+	/// Copies a string received from Lua into a reusable buffer so no Rml::String is allocated per call.
+	/// </summary>
+	struct ScratchString
+	{
+		ScratchString(std::string_view value) { m_buffer->assign(value.data(), value.size()); }
+		operator const Rml::String&() { return *m_buffer; }
+		const Rml::String& str() { return *m_buffer; }
+	private:
+		Scratch<Rml::String> m_buffer;
+	};
+
+} // end namespace Rml::SolLua
+
+
 namespace Rml::SolLua
 {
 
@@ -204,7 +329,7 @@ namespace Rml::SolLua
 namespace Rml::SolLua
 {
 
-	// Called from RmlSolLua.cpp
+	// Called from Lazy.cpp
 	void bind_color(sol::state_view& lua);
 	void bind_context(sol::state_view& lua);
 	void bind_datamodel(sol::state_view& lua);
@@ -216,6 +341,30 @@ namespace Rml::SolLua
 	void bind_global(sol::state_view& lua);
 	void bind_log(sol::state_view& lua);
 	void bind_vector(sol::state_view& lua);
-	void bind_convert(sol::state_view& lua);
+	sol::table bind_convert(sol::state_view& lua);
+	void bind_convert_as(sol::table& element_as);
+#ifdef RMLSOLLUA_FFI
+	void bind_ffi(sol::state_view& lua);
+#endif
+
+	/// <summary>
+	/// Installs a globals metatable that registers each binding group the first time one of its names is read.
+	/// </summary>
+	void bind_lazy(sol::state_view& lua);
+
+	/// <summary>
+	/// Registers every binding group that hasn't been registered yet.
+	/// </summary>
+	void ensureRegistered(sol::state_view& lua);
+
+	/// <summary>
+	/// Registers the usertypes of elements, documents, contexts and events if they aren't registered yet.
+	/// Called before RmlUi objects are handed to Lua, since their usertypes must exist by then.
+	/// </summary>
+	void ensureCoreRegistered(sol::state_view& lua);
+
+	// Defined in Element.cpp.  Copies the Element members into a usertype deriving from Element.
+	template <typename T>
+	void bind_element_members(sol::usertype<T>& usertype);
 
 } // end namespace Rml::SolLua
@@ -0,0 +1,379 @@
+#include "SolLuaAllocator.h"
+
+#include "SolLuaCallScope.h"
+
+#include <RmlUi/Core/ElementDocument.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+
+namespace Rml::SolLua
+{
+
+	struct SolLuaAllocator::FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	// Stored at the start of every ChunkSize aligned chunk, so a block finds its chunk by masking its address.
+	struct SolLuaAllocator::Chunk
+	{
+		Chunk* next = nullptr;
+		Chunk* prev = nullptr;
+		FreeBlock* free = nullptr;
+		char* bump = nullptr;
+		char* end = nullptr;
+		uint32_t used = 0;
+		uint32_t slot = 0;
+		uint32_t size_class = 0;
+		bool linked = false;
+	};
+
+	namespace
+	{
+		constexpr std::size_t align(std::size_t size, std::size_t alignment)
+		{
+			return (size + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	SolLuaAllocator* SolLuaAllocator::Install(lua_State* L)
+	{
+		if (auto existing = Get(L); existing != nullptr)
+			return existing;
+
+		// Intentionally leaked: the state keeps calling the allocator until lua_close, which may run after everything else.
+		auto allocator = new SolLuaAllocator();
+		allocator->m_previous = lua_getallocf(L, &allocator->m_previous_ud);
+		allocator->m_stats.emplace_back();
+		allocator->m_partial.emplace_back();
+		lua_setallocf(L, &SolLuaAllocator::LuaAlloc, allocator);
+		return allocator;
+	}
+
+	SolLuaAllocator* SolLuaAllocator::Get(lua_State* L)
+	{
+		void* ud = nullptr;
+		if (lua_getallocf(L, &ud) != &SolLuaAllocator::LuaAlloc)
+			return nullptr;
+		return static_cast<SolLuaAllocator*>(ud);
+	}
+
+	void SolLuaAllocator::ReleaseDocument(const Rml::ElementDocument* document)
+	{
+		auto it = m_slots.find(document);
+		if (it == m_slots.end())
+			return;
+
+		const auto slot = it->second;
+		m_stats[slot].Released = true;
+		m_slots.erase(it);
+
+		if (m_last_document == document)
+		{
+			m_last_document = nullptr;
+			m_last_slot = 0;
+		}
+
+		if (m_stats[slot].Current == 0)
+			m_free_slots.push_back(slot);
+	}
+
+	std::size_t SolLuaAllocator::GetPooledBytes() const
+	{
+		return m_chunks.size() * ChunkSize;
+	}
+
+	void* SolLuaAllocator::LuaAlloc(void* ud, void* ptr, std::size_t osize, std::size_t nsize)
+	{
+		auto self = static_cast<SolLuaAllocator*>(ud);
+
+		if (nsize == 0)
+		{
+			if (ptr != nullptr)
+				self->Free(ptr, osize);
+			return nullptr;
+		}
+
+		// When ptr is null, osize holds the type of the object being created, not a size.
+		if (ptr == nullptr)
+			return self->Allocate(nsize);
+
+		return self->Reallocate(ptr, osize, nsize);
+	}
+
+	void* SolLuaAllocator::Allocate(std::size_t size)
+	{
+		const auto slot = GetCurrentSlot();
+
+		void* result = nullptr;
+		if (size <= MaxSmallSize)
+		{
+			result = AllocateSmall(slot, static_cast<uint32_t>((size - 1) / Granularity));
+		}
+		else
+		{
+			result = m_previous(m_previous_ud, nullptr, 0, size);
+			if (result != nullptr)
+				m_large[result] = slot;
+		}
+
+		if (result != nullptr)
+			Add(slot, size, true);
+		return result;
+	}
+
+	void* SolLuaAllocator::Reallocate(void* ptr, std::size_t osize, std::size_t nsize)
+	{
+		auto chunk = FindChunk(ptr);
+		auto large = chunk == nullptr ? m_large.find(ptr) : m_large.end();
+
+		// Still fits the same pool block.
+		// Sizes are added before they are removed, so a released document's total never passes through zero while it still owns the block.
+		if (chunk != nullptr && nsize <= MaxSmallSize && (nsize - 1) / Granularity == chunk->size_class)
+		{
+			Add(chunk->slot, nsize, false);
+			Remove(chunk->slot, osize);
+			return ptr;
+		}
+
+		// Large to large goes straight to the previous allocator, which can often grow in place.
+		if (large != m_large.end() && nsize > MaxSmallSize)
+		{
+			const auto slot = large->second;
+			void* result = m_previous(m_previous_ud, ptr, osize, nsize);
+			if (result == nullptr)
+				return nullptr;
+
+			if (result != ptr)
+			{
+				m_large.erase(large);
+				m_large[result] = slot;
+			}
+			Add(slot, nsize, false);
+			Remove(slot, osize);
+			return result;
+		}
+
+		void* result = Allocate(nsize);
+		if (result == nullptr)
+		{
+			// Lua requires shrinking to succeed, so keep the old block.
+			if (nsize > osize)
+				return nullptr;
+
+			if (chunk != nullptr)
+				Remove(chunk->slot, osize - nsize);
+			else if (large != m_large.end())
+				Remove(large->second, osize - nsize);
+			return ptr;
+		}
+
+		std::memcpy(result, ptr, std::min(osize, nsize));
+		Free(ptr, osize);
+		return result;
+	}
+
+	void SolLuaAllocator::Free(void* ptr, std::size_t size)
+	{
+		if (auto chunk = FindChunk(ptr); chunk != nullptr)
+		{
+			const auto slot = chunk->slot;
+			Remove(slot, size);
+			FreeSmall(chunk, ptr);
+			Recycle(slot);
+			return;
+		}
+
+		if (auto it = m_large.find(ptr); it != m_large.end())
+		{
+			const auto slot = it->second;
+			Remove(slot, size);
+			m_large.erase(it);
+			m_previous(m_previous_ud, ptr, size, 0);
+			Recycle(slot);
+			return;
+		}
+
+		// Blocks allocated before the allocator was installed also end up here.
+		m_previous(m_previous_ud, ptr, size, 0);
+	}
+
+	void SolLuaAllocator::Recycle(uint32_t slot)
+	{
+		// Every block of a released document has been freed, so nothing refers to its slot anymore.
+		if (slot != 0 && m_stats[slot].Released && m_stats[slot].Current == 0)
+			m_free_slots.push_back(slot);
+	}
+
+	void* SolLuaAllocator::AllocateSmall(uint32_t slot, uint32_t size_class)
+	{
+		const std::size_t block_size = (size_class + 1) * Granularity;
+		auto& head = m_partial[slot][size_class];
+
+		if (head == nullptr)
+		{
+			auto chunk = m_spare[size_class];
+			if (chunk != nullptr)
+			{
+				m_spare[size_class] = nullptr;
+			}
+			else
+			{
+				void* memory = ::operator new(ChunkSize, std::align_val_t(ChunkSize), std::nothrow);
+				if (memory == nullptr)
+					return nullptr;
+
+				chunk = new (memory) Chunk();
+				chunk->bump = static_cast<char*>(memory) + align(sizeof(Chunk), Granularity);
+				chunk->end = static_cast<char*>(memory) + ChunkSize;
+				chunk->size_class = size_class;
+				m_chunks.insert(reinterpret_cast<uintptr_t>(memory));
+			}
+
+			chunk->slot = slot;
+			chunk->linked = true;
+			head = chunk;
+		}
+
+		auto chunk = head;
+		void* result;
+		if (chunk->free != nullptr)
+		{
+			result = chunk->free;
+			chunk->free = chunk->free->next;
+		}
+		else
+		{
+			result = chunk->bump;
+			chunk->bump += block_size;
+		}
+		++chunk->used;
+
+		// Full chunks leave the list until a block is freed.
+		if (chunk->free == nullptr && chunk->bump + block_size > chunk->end)
+		{
+			head = chunk->next;
+			if (head != nullptr)
+				head->prev = nullptr;
+			chunk->next = chunk->prev = nullptr;
+			chunk->linked = false;
+		}
+
+		return result;
+	}
+
+	void SolLuaAllocator::FreeSmall(Chunk* chunk, void* ptr)
+	{
+		auto& head = m_partial[chunk->slot][chunk->size_class];
+
+		auto block = static_cast<FreeBlock*>(ptr);
+		block->next = chunk->free;
+		chunk->free = block;
+		--chunk->used;
+
+		if (chunk->used == 0)
+		{
+			if (chunk->linked)
+			{
+				if (chunk->prev != nullptr)
+					chunk->prev->next = chunk->next;
+				else
+					head = chunk->next;
+				if (chunk->next != nullptr)
+					chunk->next->prev = chunk->prev;
+			}
+
+			// Keep one empty chunk per size class, so a block allocated and freed in a loop doesn't map a chunk each time.
+			if (m_spare[chunk->size_class] == nullptr)
+			{
+				chunk->next = chunk->prev = nullptr;
+				chunk->free = nullptr;
+				chunk->bump = reinterpret_cast<char*>(chunk) + align(sizeof(Chunk), Granularity);
+				chunk->linked = false;
+				m_spare[chunk->size_class] = chunk;
+				return;
+			}
+
+			m_chunks.erase(reinterpret_cast<uintptr_t>(chunk));
+			chunk->~Chunk();
+			::operator delete(static_cast<void*>(chunk), std::align_val_t(ChunkSize));
+			return;
+		}
+
+		if (!chunk->linked)
+		{
+			chunk->prev = nullptr;
+			chunk->next = head;
+			if (head != nullptr)
+				head->prev = chunk;
+			head = chunk;
+			chunk->linked = true;
+		}
+	}
+
+	SolLuaAllocator::Chunk* SolLuaAllocator::FindChunk(void* ptr) const
+	{
+		const auto base = reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(ChunkSize - 1);
+		if (m_chunks.find(base) == m_chunks.end())
+			return nullptr;
+		return reinterpret_cast<Chunk*>(base);
+	}
+
+	uint32_t SolLuaAllocator::GetCurrentSlot()
+	{
+		auto document = SolLuaCallScope::GetDocument();
+		if (document == m_last_document)
+			return m_last_slot;
+
+		uint32_t slot = 0;
+		if (document != nullptr)
+		{
+			if (auto it = m_slots.find(document); it != m_slots.end())
+			{
+				slot = it->second;
+			}
+			else
+			{
+				if (!m_free_slots.empty())
+				{
+					slot = m_free_slots.back();
+					m_free_slots.pop_back();
+					m_stats[slot] = Stats();
+				}
+				else
+				{
+					slot = static_cast<uint32_t>(m_stats.size());
+					m_stats.emplace_back();
+					m_partial.emplace_back();
+				}
+				m_stats[slot].Name = document->GetSourceURL();
+				m_slots[document] = slot;
+			}
+		}
+
+		m_last_document = document;
+		m_last_slot = slot;
+		return slot;
+	}
+
+	void SolLuaAllocator::Add(uint32_t slot, std::size_t size, bool allocation)
+	{
+		for (auto stats : { &m_stats[slot], &m_total })
+		{
+			stats->Current += size;
+			stats->Peak = std::max(stats->Peak, stats->Current);
+			if (allocation)
+				++stats->Allocations;
+		}
+	}
+
+	void SolLuaAllocator::Remove(uint32_t slot, std::size_t size)
+	{
+		for (auto stats : { &m_stats[slot], &m_total })
+			stats->Current -= std::min(stats->Current, size);
+	}
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <RmlUi/Core/Types.h>
+
+#include <sol/sol.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Rml
+{
+	class ElementDocument;
+}
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Lua allocator that attributes memory to the document whose code is running (see SolLuaCallScope).
+	/// Small blocks come from fixed size pools; each pool chunk belongs to a single document, so no per-block header is needed.
+	/// Larger blocks are forwarded to the allocator that was installed before.
+	/// </summary>
+	class SolLuaAllocator
+	{
+	public:
+		struct Stats
+		{
+			Rml::String Name;
+			std::size_t Current = 0;
+			std::size_t Peak = 0;
+			std::size_t Allocations = 0;
+			bool Released = false;
+		};
+
+		/// <summary>
+		/// Installs the allocator on a state through lua_setallocf.
+		/// Blocks allocated before are still freed through the previous allocator.
+		/// The allocator is never destroyed, as Lua frees blocks with it until lua_close.
+		/// LuaJIT without GC64 needs memory in the low address space and can't use it.
+		/// </summary>
+		/// <param name="L">The Lua state.</param>
+		/// <returns>The installed allocator.</returns>
+		static SolLuaAllocator* Install(lua_State* L);
+
+		/// <summary>
+		/// Gets the allocator installed on a state.
+		/// </summary>
+		/// <param name="L">The Lua state.</param>
+		/// <returns>The allocator, or nullptr if the state uses another allocator.</returns>
+		static SolLuaAllocator* Get(lua_State* L);
+
+		/// <summary>
+		/// Stops attributing new allocations to a document that is being destroyed.
+		/// Its entry is kept until later collections have freed the memory it allocated, then reused by the next new document.
+		/// </summary>
+		/// <param name="document">The document.</param>
+		void ReleaseDocument(const Rml::ElementDocument* document);
+
+		/// <summary>
+		/// Gets the stats of every document.  Index 0 holds allocations made outside any document.
+		/// Released entries with no memory left are waiting to be reused.
+		/// </summary>
+		const Rml::Vector<Stats>& GetStats() const { return m_stats; }
+
+		/// <summary>
+		/// Gets the stats of the whole state.
+		/// </summary>
+		const Stats& GetTotal() const { return m_total; }
+
+		/// <summary>
+		/// Gets the bytes reserved by the small block pools.
+		/// </summary>
+		std::size_t GetPooledBytes() const;
+
+	private:
+		struct FreeBlock;
+		struct Chunk;
+
+		static constexpr std::size_t ChunkSize = 16 * 1024;
+		static constexpr std::size_t Granularity = 16;
+		static constexpr std::size_t MaxSmallSize = 256;
+		static constexpr std::size_t ClassCount = MaxSmallSize / Granularity;
+
+		SolLuaAllocator() = default;
+
+		static void* LuaAlloc(void* ud, void* ptr, std::size_t osize, std::size_t nsize);
+
+		void* Allocate(std::size_t size);
+		void* Reallocate(void* ptr, std::size_t osize, std::size_t nsize);
+		void Free(void* ptr, std::size_t size);
+
+		void* AllocateSmall(uint32_t slot, uint32_t size_class);
+		void FreeSmall(Chunk* chunk, void* ptr);
+		void Recycle(uint32_t slot);
+		Chunk* FindChunk(void* ptr) const;
+
+		uint32_t GetCurrentSlot();
+		void Add(uint32_t slot, std::size_t size, bool allocation);
+		void Remove(uint32_t slot, std::size_t size);
+
+		lua_Alloc m_previous = nullptr;
+		void* m_previous_ud = nullptr;
+
+		// Chunks with free blocks, per slot and size class.
+		Rml::Vector<std::array<Chunk*, ClassCount>> m_partial;
+		// One empty chunk per size class, not owned by any slot.
+		std::array<Chunk*, ClassCount> m_spare{};
+		Rml::UnorderedSet<uintptr_t> m_chunks;
+		Rml::UnorderedMap<void*, uint32_t> m_large;
+
+		Rml::UnorderedMap<const Rml::ElementDocument*, uint32_t> m_slots;
+		Rml::Vector<uint32_t> m_free_slots;
+		const Rml::ElementDocument* m_last_document = nullptr;
+		uint32_t m_last_slot = 0;
+
+		Rml::Vector<Stats> m_stats;
+		Stats m_total;
+	};
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,258 @@
+#include "RmlSolLua/RmlSolLuaBundle.h"
+
+#include "SolLuaBundle.h"
+
+#include <RmlUi/Core/Log.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+namespace Rml::SolLua
+{
+
+	/// <summary>
+	/// A read-only mapping of a whole file.
+	/// </summary>
+	struct BundleFileInterface::Mapping
+	{
+		const char* data = nullptr;
+		std::size_t size = 0;
+
+		~Mapping()
+		{
+			if (data == nullptr)
+				return;
+#ifdef _WIN32
+			UnmapViewOfFile(data);
+#else
+			munmap(const_cast<char*>(data), size);
+#endif
+		}
+
+		bool Map(const Rml::String& path)
+		{
+#ifdef _WIN32
+			HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER length;
+			HANDLE mapping = nullptr;
+			if (GetFileSizeEx(file, &length) && length.QuadPart > 0)
+				mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			CloseHandle(file);
+			if (mapping == nullptr)
+				return false;
+
+			data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			CloseHandle(mapping);
+			size = data != nullptr ? static_cast<std::size_t>(length.QuadPart) : 0;
+#else
+			const int file = open(path.c_str(), O_RDONLY);
+			if (file < 0)
+				return false;
+
+			struct stat info;
+			void* address = MAP_FAILED;
+			if (fstat(file, &info) == 0 && info.st_size > 0)
+				address = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+			close(file);
+			if (address == MAP_FAILED)
+				return false;
+
+			data = static_cast<const char*>(address);
+			size = static_cast<std::size_t>(info.st_size);
+#endif
+			return data != nullptr;
+		}
+	};
+
+	namespace
+	{
+		/// <summary>
+		/// An open file: either a view into a bundle, or a handle of the fallback interface.
+		/// </summary>
+		struct BundleFile
+		{
+			std::string_view data;
+			std::size_t position = 0;
+			Rml::FileHandle fallback = 0;
+		};
+
+		BundleFile* getFile(Rml::FileHandle file)
+		{
+			return reinterpret_cast<BundleFile*>(file);
+		}
+
+		Rml::String normalise(Rml::String path)
+		{
+			std::replace(path.begin(), path.end(), '\\', '/');
+			return path;
+		}
+	}
+
+	BundleFileInterface::BundleFileInterface(Rml::FileInterface* fallback)
+		: m_fallback(fallback)
+	{}
+
+	BundleFileInterface::~BundleFileInterface() = default;
+
+	bool BundleFileInterface::Mount(const Rml::String& path)
+	{
+		auto mapping = Rml::MakeUnique<Mapping>();
+		if (!mapping->Map(path))
+		{
+			Rml::Log::Message(Rml::Log::LT_ERROR, "[LUA][BUNDLE] Unable to map %s.", path.c_str());
+			return false;
+		}
+
+		const char* data = mapping->data;
+		const std::size_t size = mapping->size;
+		auto invalid = [&path](const char* reason) {
+			Rml::Log::Message(Rml::Log::LT_ERROR, "[LUA][BUNDLE] %s is not a valid bundle: %s.", path.c_str(), reason);
+			return false;
+		};
+
+		if (size < Bundle::HeaderSize || std::memcmp(data, Bundle::Magic, sizeof(Bundle::Magic)) != 0)
+			return invalid("bad header");
+		if (Bundle::Read<uint32_t>(data + 4) != Bundle::Version)
+			return invalid("unsupported version");
+
+		const auto count = Bundle::Read<uint32_t>(data + 8);
+		const auto index_size = Bundle::Read<uint32_t>(data + 12);
+		if (index_size > size - Bundle::HeaderSize)
+			return invalid("truncated index");
+		// Checked before reserving, so a corrupt count can't ask for a huge allocation.
+		if (count > index_size / Bundle::EntrySize)
+			return invalid("truncated index");
+
+		// Validate every entry before adding any.
+		Rml::Vector<std::pair<Rml::String, File>> files;
+		files.reserve(count);
+		const char* entry = data + Bundle::HeaderSize;
+		const char* index_end = entry + index_size;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (static_cast<std::size_t>(index_end - entry) < Bundle::EntrySize)
+				return invalid("truncated index");
+
+			const auto path_length = Bundle::Read<uint32_t>(entry);
+			const auto flags = Bundle::Read<uint32_t>(entry + 4);
+			const auto offset = Bundle::Read<uint64_t>(entry + 8);
+			const auto length = Bundle::Read<uint64_t>(entry + 16);
+			entry += Bundle::EntrySize;
+
+			if (path_length > static_cast<std::size_t>(index_end - entry))
+				return invalid("truncated index");
+			if (offset > size || length > size - offset)
+				return invalid("file out of range");
+
+			files.emplace_back(Rml::String(entry, path_length), File{ std::string_view(data + offset, static_cast<std::size_t>(length)), flags });
+			entry += path_length;
+		}
+
+		for (auto& [file_path, file] : files)
+			m_files[std::move(file_path)] = file;
+		m_mappings.push_back(std::move(mapping));
+		return true;
+	}
+
+	bool BundleFileInterface::Find(const Rml::String& path, std::string_view& data, bool* bytecode) const
+	{
+		auto iter = m_files.find(path);
+		if (iter == m_files.end() && path.find('\\') != Rml::String::npos)
+			iter = m_files.find(normalise(path));
+		if (iter == m_files.end())
+			return false;
+
+		data = iter->second.Data;
+		if (bytecode != nullptr)
+			*bytecode = (iter->second.Flags & Bundle::Bytecode) != 0;
+		return true;
+	}
+
+	Rml::FileHandle BundleFileInterface::Open(const Rml::String& path)
+	{
+		std::string_view data;
+		if (Find(path, data))
+			return reinterpret_cast<Rml::FileHandle>(new BundleFile{ data });
+
+		if (m_fallback == nullptr)
+			return 0;
+
+		auto handle = m_fallback->Open(path);
+		if (handle == 0)
+			return 0;
+
+		return reinterpret_cast<Rml::FileHandle>(new BundleFile{ {}, 0, handle });
+	}
+
+	void BundleFileInterface::Close(Rml::FileHandle file)
+	{
+		auto f = getFile(file);
+		if (f->fallback != 0)
+			m_fallback->Close(f->fallback);
+		delete f;
+	}
+
+	size_t BundleFileInterface::Read(void* buffer, size_t size, Rml::FileHandle file)
+	{
+		auto f = getFile(file);
+		if (f->fallback != 0)
+			return m_fallback->Read(buffer, size, f->fallback);
+
+		size = std::min(size, f->data.size() - f->position);
+		std::memcpy(buffer, f->data.data() + f->position, size);
+		f->position += size;
+		return size;
+	}
+
+	bool BundleFileInterface::Seek(Rml::FileHandle file, long offset, int origin)
+	{
+		auto f = getFile(file);
+		if (f->fallback != 0)
+			return m_fallback->Seek(f->fallback, offset, origin);
+
+		long base = 0;
+		if (origin == SEEK_CUR)
+			base = static_cast<long>(f->position);
+		else if (origin == SEEK_END)
+			base = static_cast<long>(f->data.size());
+
+		const long position = base + offset;
+		if (position < 0 || position > static_cast<long>(f->data.size()))
+			return false;
+
+		f->position = static_cast<std::size_t>(position);
+		return true;
+	}
+
+	size_t BundleFileInterface::Tell(Rml::FileHandle file)
+	{
+		auto f = getFile(file);
+		if (f->fallback != 0)
+			return m_fallback->Tell(f->fallback);
+		return f->position;
+	}
+
+	size_t BundleFileInterface::Length(Rml::FileHandle file)
+	{
+		auto f = getFile(file);
+		if (f->fallback != 0)
+			return m_fallback->Length(f->fallback);
+		return f->data.size();
+	}
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+
+namespace Rml::SolLua::Bundle
+{
+	// Layout of a bundle, shared by BundleFileInterface and RmlSolLua_pack.
+	// Integers are stored in host byte order, and only little-endian hosts are supported.
+	//
+	//   Header  magic "RSLB", uint32 version, uint32 entry count, uint32 index size in bytes
+	//   Index   per entry: uint32 path length, uint32 flags, uint64 offset, uint64 size, then the path
+	//   Data    file contents at offsets from the start of the bundle, each aligned to 8 bytes
+
+	constexpr char Magic[4] = { 'R', 'S', 'L', 'B' };
+	constexpr uint32_t Version = 1;
+	constexpr std::size_t HeaderSize = 16;
+	constexpr std::size_t EntrySize = 24;
+	constexpr std::size_t Alignment = 8;
+
+	enum Flags : uint32_t
+	{
+		// Precompiled Lua.  It is loaded as is, so it must come from the Lua build of the program.
+		Bytecode = 1,
+	};
+
+	template <typename T>
+	T Read(const char* p)
+	{
+		T value;
+		std::memcpy(&value, p, sizeof(T));
+		return value;
+	}
+
+	template <typename T>
+	void Write(std::string& out, T value)
+	{
+		out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+} // end namespace Rml::SolLua::Bundle
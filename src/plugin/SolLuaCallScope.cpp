@@ -0,0 +1,64 @@
+#include "SolLuaCallScope.h"
+
+#include "SolLuaLatency.h"
+#include "SolLuaRecorder.h"
+#include "SolLuaTrace.h"
+
+
+namespace Rml::SolLua
+{
+
+	namespace
+	{
+		thread_local Rml::ElementDocument* current_document = nullptr;
+		thread_local int depth = 0;
+	}
+
+	SolLuaCallScope::SolLuaCallScope(SolLuaStats::CallType type, Rml::ElementDocument* document, const Rml::String* label)
+		: m_previous(current_document), m_label(IsTiming() ? label : nullptr), m_type(type), m_measure(depth == 0 && SolLuaRecorder::IsMeasuring())
+	{
+		current_document = document;
+		++depth;
+		SolLuaStats::AddCall(type);
+
+		// A replay measures the outermost scopes only, so nested calls aren't counted twice.
+		if (m_label != nullptr || m_measure)
+			m_start = std::chrono::steady_clock::now();
+	}
+
+	SolLuaCallScope::~SolLuaCallScope()
+	{
+		auto document = current_document;
+		current_document = m_previous;
+		--depth;
+
+		if (m_label == nullptr && !m_measure)
+			return;
+
+		const auto end = std::chrono::steady_clock::now();
+		if (m_measure)
+			SolLuaRecorder::AddLuaTime(std::chrono::duration<double, std::milli>(end - m_start).count());
+		if (m_label == nullptr)
+			return;
+
+		if (SolLuaLatency::IsEnabled())
+		{
+			// A listener's label lives in the listener, so its address tells apart listeners with the same label.
+			const void* identity = m_type == SolLuaStats::CallType::Listener ? m_label : nullptr;
+			SolLuaLatency::Record(*m_label, identity, std::chrono::duration<double, std::milli>(end - m_start).count());
+		}
+		if (SolLuaTrace::IsEnabled())
+			SolLuaTrace::Record(*m_label, document, m_start, end);
+	}
+
+	bool SolLuaCallScope::IsTiming()
+	{
+		return SolLuaLatency::IsEnabled() || SolLuaTrace::IsEnabled();
+	}
+
+	Rml::ElementDocument* SolLuaCallScope::GetDocument()
+	{
+		return current_document;
+	}
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "SolLuaStats.h"
+
+#include <RmlUi/Core/Types.h>
+
+#include <chrono>
+
+
+namespace Rml
+{
+	class ElementDocument;
+}
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Marks the document whose Lua code is running on this thread.
+	/// Constructed at every place the library calls into Lua: document scripts, inline scripts and event listeners.
+	/// </summary>
+	class SolLuaCallScope
+	{
+	public:
+		/// <summary>
+		/// Enters the scope of a document.
+		/// </summary>
+		/// <param name="type">The kind of entry point, counted in the runtime stats.</param>
+		/// <param name="document">The document running Lua code, or nullptr for code not owned by a document.</param>
+		/// <param name="label">Identifies the entry point in latency stats and traces.  Must outlive the scope.  Unlabelled scopes are not timed.</param>
+		SolLuaCallScope(SolLuaStats::CallType type, Rml::ElementDocument* document, const Rml::String* label = nullptr);
+		~SolLuaCallScope();
+
+		SolLuaCallScope(const SolLuaCallScope&) = delete;
+		SolLuaCallScope& operator=(const SolLuaCallScope&) = delete;
+
+		/// <summary>
+		/// Gets the document of the innermost scope on this thread.
+		/// </summary>
+		/// <returns>The document, or nullptr outside any document scope.</returns>
+		static Rml::ElementDocument* GetDocument();
+
+		/// <summary>
+		/// Checks whether labelled scopes are timed, so callers can skip building labels otherwise.
+		/// </summary>
+		/// <returns>True if latency tracking or tracing is on.</returns>
+		static bool IsTiming();
+
+	private:
+		Rml::ElementDocument* m_previous;
+		const Rml::String* m_label;
+		SolLuaStats::CallType m_type;
+		bool m_measure;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+} // end namespace Rml::SolLua
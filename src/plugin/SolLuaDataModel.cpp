@@ -1,11 +1,71 @@
 #include "SolLuaDataModel.h"
 
+#include "SolLuaCallScope.h"
+
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+
 #include <optional>
 
 
 namespace Rml::SolLua
 {
 
+	namespace
+	{
+		// Every live data model, for the runtime stats.
+		Rml::UnorderedSet<SolLuaDataModel*>& getDataModels()
+		{
+			static Rml::UnorderedSet<SolLuaDataModel*> models;
+			return models;
+		}
+	}
+
+	SolLuaDataModel::SolLuaDataModel(sol::state_view s)
+		: Lua{ s }
+	{
+		getDataModels().insert(this);
+	}
+
+	SolLuaDataModel::~SolLuaDataModel()
+	{
+		getDataModels().erase(this);
+	}
+
+	bool SolLuaDataModel::Close()
+	{
+		if (Name.empty())
+			return false;
+
+		// Removing the model destroys its bindings, which point into ObjectList.
+		bool removed = false;
+		if (auto context = Rml::GetContext(ContextName); context != nullptr)
+			removed = context->RemoveDataModel(Name);
+
+		Name.clear();
+		ContextName.clear();
+		Constructor = Rml::DataModelConstructor();
+		Handle = Rml::DataModelHandle();
+		ObjectList.clear();
+		Table = sol::lua_nil;
+		return removed;
+	}
+
+	std::size_t SolLuaDataModel::GetLiveCount()
+	{
+		return getDataModels().size();
+	}
+
+	std::size_t SolLuaDataModel::GetLiveObjectCount()
+	{
+		std::size_t count = 0;
+		for (auto model : getDataModels())
+			count += model->ObjectList.size();
+		return count;
+	}
+
+	//-----------------------------------------------------
+
 	SolLuaObjectDef::SolLuaObjectDef(SolLuaDataModel* model)
 		: VariableDefinition(DataVariableType::Scalar), m_model(model)
 	{
@@ -13,6 +73,9 @@ namespace Rml::SolLua
 
 	bool SolLuaObjectDef::Get(void* ptr, Rml::Variant& variant)
 	{
+		static const Rml::String label{ "DataModel.Get" };
+		SolLuaCallScope scope{ SolLuaStats::CallType::DataModel, SolLuaCallScope::GetDocument(), &label };
+
 		auto obj = static_cast<sol::object*>(ptr);
 
 		if (obj->is<bool>())
@@ -72,6 +135,9 @@ namespace Rml::SolLua
 
 	DataVariable SolLuaObjectDef::Child(void* ptr, const Rml::DataAddressEntry& address)
 	{
+		static const Rml::String label{ "DataModel.Child" };
+		SolLuaCallScope scope{ SolLuaStats::CallType::DataModel, SolLuaCallScope::GetDocument(), &label };
+
 		// Child should be called on a table.
 		auto object = static_cast<sol::object*>(ptr);
 		if (object->get_type() != sol::type::table)
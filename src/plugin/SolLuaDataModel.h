@@ -17,7 +17,25 @@ namespace Rml::SolLua
 
 	struct SolLuaDataModel
 	{
-		SolLuaDataModel(sol::state_view s) : Lua{ s } {}
+		SolLuaDataModel(sol::state_view s);
+		~SolLuaDataModel();
+
+		/// <summary>
+		/// Removes the data model from its context and releases the Lua values it holds.
+		/// Only the SolLuaDataModel that created the model can close it.
+		/// </summary>
+		/// <returns>True if the model was removed.</returns>
+		bool Close();
+
+		/// <summary>
+		/// Gets the number of live data models.
+		/// </summary>
+		static std::size_t GetLiveCount();
+
+		/// <summary>
+		/// Gets the number of Lua values held by the live data models.
+		/// </summary>
+		static std::size_t GetLiveObjectCount();
 
 		Rml::DataModelConstructor Constructor;
 		Rml::DataModelHandle Handle;
@@ -27,6 +45,10 @@ namespace Rml::SolLua
 		// sol data types are reference counted.  Hold onto them as we use them.
 		sol::table Table;
 		std::unordered_map<std::string, sol::object> ObjectList;
+
+		// Set when this object created the model.  The context is looked up by name in case it was destroyed first.
+		Rml::String ContextName;
+		Rml::String Name;
 	};
 
 	class SolLuaObjectDef final : public Rml::VariableDefinition
@@ -1,5 +1,11 @@
 #include "SolLuaDocument.h"
 
+#include "SolLuaAllocator.h"
+#include "SolLuaCallScope.h"
+#include "SolLuaErrors.h"
+#include "SolLuaModules.h"
+#include "SolLuaWatchdog.h"
+
 #include <RmlUi/Core/Stream.h>
 #include <RmlUi/Core/Log.h>
 #include <RmlUi/Core/Context.h>
@@ -14,7 +20,7 @@ namespace Rml::SolLua
 		if (!pfr.valid())
 		{
 			sol::error err = pfr;
-			Rml::Log::Message(Rml::Log::LT_ERROR, "[LUA][ERROR] %s", err.what());
+			SolLuaErrors::Report(err.what());
 		}
 		return pfr;
 	}
@@ -25,22 +31,33 @@ namespace Rml::SolLua
 		: m_state(state), ElementDocument(tag), m_environment(state, sol::create, state.globals()), m_lua_env_identifier(lua_env_identifier)
 	{
 		m_environment["document"] = this;
+		++SolLuaStats::Get().Documents;
+	}
+
+	SolLuaDocument::~SolLuaDocument()
+	{
+		--SolLuaStats::Get().Documents;
+		if (auto allocator = SolLuaAllocator::Get(m_state.lua_state()); allocator != nullptr)
+			allocator->ReleaseDocument(this);
 	}
 
 	void SolLuaDocument::LoadInlineScript(const Rml::String& content, const Rml::String& source_path, int source_line)
 	{
 		auto* context = GetContext();
 
+		Rml::String label{ "[" };
+		label.append(context->GetName());
+		label.append("][");
+		label.append(GetSourceURL());
+		label.append("]:");
+		label.append(Rml::ToString(source_line));
+
 		Rml::String buffer{ "--" };
-		buffer.append("[");
-		buffer.append(context->GetName());
-		buffer.append("][");
-		buffer.append(GetSourceURL());
-		buffer.append("]:");
-		buffer.append(Rml::ToString(source_line));
+		buffer.append(label);
 		buffer.append("\n");
 		buffer.append(content);
 
+		SolLuaCallScope scope{ SolLuaStats::CallType::Script, this, &label };
 		if (!m_lua_env_identifier.empty())
 			m_environment[m_lua_env_identifier] = GetId();
 
@@ -52,32 +69,64 @@ namespace Rml::SolLua
 		if (!m_lua_env_identifier.empty())
 			m_environment[m_lua_env_identifier] = GetId();
 
-		// use the file interface to get the contents of the script
-		FileInterface* file_interface = GetFileInterface();
-		FileHandle handle = file_interface->Open(source_path);
-		if (handle == 0)
+		// use the file interface to get the contents of the script, or a view of it from a bundle
+		Rml::String buffer;
+		std::string_view source;
+		bool bytecode = false;
+		if (!SolLuaModules::ReadFile(source_path, buffer, source, bytecode))
 		{
 			Log::Message(Log::LT_WARNING, "LoadFile: Unable to open file: %s", source_path.c_str());
 			return;
 		}
 
-		size_t size = file_interface->Length(handle);
-		if (size == 0)
+		if (source.empty())
 		{
 			Log::Message(Log::LT_WARNING, "LoadFile: File is 0 bytes in size: %s", source_path.c_str());
 			return;
 		}
-		UniquePtr<char[]> file_contents(new char[size]);
-		file_interface->Read(file_contents.get(), size, handle);
-		file_interface->Close(handle);
 
 		Rml::String chunkname = "@" + source_path;
-		std::string_view source(file_contents.get(), size);
-		m_state.safe_script(source, m_environment, ErrorHandler, chunkname);
+		SolLuaCallScope scope{ SolLuaStats::CallType::Script, this, &chunkname };
+
+		// Documents sharing a script compile it once.
+		auto L = m_state.lua_state();
+		if (SolLuaModules::LoadChunk(L, source, chunkname, bytecode) != 0)
+		{
+			SolLuaErrors::Report(lua_tostring(L, -1));
+			lua_pop(L, 1);
+			return;
+		}
+
+		sol::protected_function chunk{ L, -1 };
+		lua_pop(L, 1);
+		sol::set_environment(m_environment, chunk);
+		auto result = chunk();
+		if (!result.valid())
+			ErrorHandler(L, std::move(result));
+	}
+
+	void SolLuaDocument::ClearLuaEnvironment()
+	{
+		if (!m_environment.valid())
+			return;
+
+		// Keys can't be removed while iterating with lua_next, so gather them first.
+		Rml::Vector<sol::object> keys;
+		for (auto& [key, value] : m_environment)
+			keys.push_back(key);
+
+		for (auto& key : keys)
+			m_environment.raw_set(key, sol::lua_nil);
 	}
 
 	sol::protected_function_result SolLuaDocument::RunLuaScript(const Rml::String& script)
 	{
+		Rml::String label;
+		if (SolLuaCallScope::IsTiming() || SolLuaWatchdog::IsEnabled())
+			label = "[" + GetSourceURL() + "] RunLuaScript";
+
+		SolLuaCallScope scope{ SolLuaStats::CallType::Script, this, label.empty() ? nullptr : &label };
+		SolLuaWatchdog::Scope watchdog{ m_state.lua_state(), &label };
 		if (!m_lua_env_identifier.empty())
 			m_environment[m_lua_env_identifier] = GetId();
 
@@ -8,7 +8,7 @@
 namespace Rml::SolLua
 {
 	/// <summary>
-	/// Lua error handler.
+	/// Lua error handler.  Reports through SolLuaErrors, which deduplicates repeated errors.
 	/// </summary>
 	/// <param name="">(Unused) Lua state.</param>
 	/// <param name="pfr">The result that holds our error.</param>
@@ -25,6 +25,7 @@ namespace Rml::SolLua
 		/// <param name="state">The Lua state to register into.</param>
 		/// <param name="tag">The document tag (body).</param>
 		SolLuaDocument(sol::state_view state, const Rml::String& tag, const Rml::String& lua_env_identifier);
+		~SolLuaDocument();
 
 		/// <summary>
 		/// Loads an inline script.
@@ -47,6 +48,12 @@ namespace Rml::SolLua
 		/// <returns>The result of the script.</returns>
 		sol::protected_function_result RunLuaScript(const Rml::String& script);
 
+		/// <summary>
+		/// Removes every variable from the Lua environment so what it references can be collected.
+		/// Called when the document is unloaded.
+		/// </summary>
+		void ClearLuaEnvironment();
+
 		/// <summary>
 		/// Gets the Lua environment attached to this document.
 		/// </summary>
@@ -0,0 +1,229 @@
+#include "SolLuaErrors.h"
+
+#include <RmlUi/Core/Log.h>
+
+#include <algorithm>
+#include <chrono>
+
+
+namespace Rml::SolLua
+{
+
+	namespace
+	{
+		using clock = std::chrono::steady_clock;
+
+		// Messages without a position are keyed by their text, so errors with changing text would add entries forever.
+		constexpr std::size_t MaxEntries = 256;
+
+		struct Entry
+		{
+			ErrorStats stats;
+			uint64_t pending = 0;	// Repeats since the last summary.
+			clock::time_point last_summary;
+		};
+
+		struct Errors
+		{
+			Rml::UnorderedMap<Rml::String, Entry> entries;
+			ErrorCallback callback;
+
+			clock::duration interval = std::chrono::seconds(5);
+			int max_new_per_second = 20;
+			clock::time_point window_start;
+			int window_count = 0;
+
+			bool has_pending = false;
+		};
+
+		Errors& getErrors()
+		{
+			static Errors errors;
+			return errors;
+		}
+
+		/// <summary>
+		/// Gets the "chunk:line" a message starts with, or its first line if it has no position.
+		/// Chunk names can hold ':', so the key ends at the first ':' that follows ':' and digits.
+		/// </summary>
+		Rml::String getKey(const char* message, std::size_t length)
+		{
+			const auto end = std::find(message, message + length, '\n');
+			for (auto colon = std::find(message, end, ':'); colon != end; colon = std::find(colon + 1, end, ':'))
+			{
+				auto digits = colon + 1;
+				while (digits != end && *digits >= '0' && *digits <= '9')
+					++digits;
+
+				if (digits != colon + 1 && digits != end && *digits == ':')
+					return Rml::String(message, digits);
+			}
+			return Rml::String(message, end);
+		}
+
+		Rml::String getFirstLine(const Rml::String& message)
+		{
+			return message.substr(0, message.find('\n'));
+		}
+
+		void logSummary(Entry& entry, clock::time_point now)
+		{
+			const auto seconds = std::chrono::duration<double>(now - entry.last_summary).count();
+			Rml::Log::Message(Rml::Log::LT_ERROR, "[LUA][ERROR] %s: repeated %llu times in %.0fs, %llu in total.  Last: %s",
+				entry.stats.Key.c_str(), static_cast<unsigned long long>(entry.pending), seconds,
+				static_cast<unsigned long long>(entry.stats.Count), getFirstLine(entry.stats.LastMessage).c_str());
+
+			entry.pending = 0;
+			entry.last_summary = now;
+		}
+
+		/// <summary>
+		/// Makes room for a new entry by dropping the one with the fewest errors, after logging its pending summary.
+		/// </summary>
+		void evict(Errors& errors, clock::time_point now)
+		{
+			auto least = errors.entries.begin();
+			for (auto iter = errors.entries.begin(); iter != errors.entries.end(); ++iter)
+			{
+				if (iter->second.stats.Count < least->second.stats.Count)
+					least = iter;
+			}
+
+			if (least->second.pending != 0 && !errors.callback)
+				logSummary(least->second, now);
+			errors.entries.erase(least);
+		}
+	}
+
+	void SolLuaErrors::Report(const Rml::String& message)
+	{
+		auto& errors = getErrors();
+		const auto now = clock::now();
+
+		auto key = getKey(message.data(), message.size());
+		if (errors.entries.size() >= MaxEntries && errors.entries.find(key) == errors.entries.end())
+			evict(errors, now);
+
+		auto [iter, inserted] = errors.entries.try_emplace(key);
+		auto& entry = iter->second;
+		++entry.stats.Count;
+		entry.stats.LastMessage = message;
+		if (inserted)
+		{
+			entry.stats.Key = std::move(key);
+			entry.stats.FirstMessage = message;
+			entry.last_summary = now;
+		}
+
+		if (errors.callback)
+		{
+			errors.callback(entry.stats.Key, message, entry.stats.Count);
+			return;
+		}
+
+		if (inserted)
+		{
+			if (errors.max_new_per_second > 0)
+			{
+				if (now - errors.window_start >= std::chrono::seconds(1))
+				{
+					errors.window_start = now;
+					errors.window_count = 0;
+				}
+				if (++errors.window_count > errors.max_new_per_second)
+				{
+					++entry.stats.Suppressed;
+					++entry.pending;
+					errors.has_pending = true;
+					return;
+				}
+			}
+
+			Rml::Log::Message(Rml::Log::LT_ERROR, "[LUA][ERROR] %s", message.c_str());
+			return;
+		}
+
+		++entry.stats.Suppressed;
+		++entry.pending;
+		errors.has_pending = true;
+		if (now - entry.last_summary >= errors.interval)
+			logSummary(entry, now);
+	}
+
+	void SolLuaErrors::Tick()
+	{
+		auto& errors = getErrors();
+		if (!errors.has_pending)
+			return;
+
+		const auto now = clock::now();
+		errors.has_pending = false;
+		for (auto& [key, entry] : errors.entries)
+		{
+			if (entry.pending == 0)
+				continue;
+
+			if (now - entry.last_summary >= errors.interval)
+				logSummary(entry, now);
+			else
+				errors.has_pending = true;
+		}
+	}
+
+	void SolLuaErrors::Configure(double summary_interval, int max_new_per_second)
+	{
+		auto& errors = getErrors();
+		errors.interval = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(summary_interval));
+		errors.max_new_per_second = max_new_per_second;
+	}
+
+	void SolLuaErrors::SetCallback(ErrorCallback callback)
+	{
+		getErrors().callback = std::move(callback);
+	}
+
+	Rml::Vector<ErrorStats> SolLuaErrors::GetStats()
+	{
+		Rml::Vector<ErrorStats> stats;
+		for (const auto& [key, entry] : getErrors().entries)
+			stats.push_back(entry.stats);
+
+		std::sort(stats.begin(), stats.end(), [](const ErrorStats& a, const ErrorStats& b) { return a.Count > b.Count; });
+		return stats;
+	}
+
+	void SolLuaErrors::Reset()
+	{
+		auto& errors = getErrors();
+		errors.entries.clear();
+		errors.has_pending = false;
+	}
+
+	int SolLuaErrors::MessageHandler(lua_State* L)
+	{
+		std::size_t length = 0;
+		const char* message = lua_tolstring(L, 1, &length);
+		if (message == nullptr)
+			return 1;
+
+		bool seen;
+		{
+			const auto& entries = getErrors().entries;
+			seen = entries.find(getKey(message, length)) != entries.end();
+		}
+		if (seen)
+			return 1;
+
+		luaL_traceback(L, L, message, 1);
+		return 1;
+	}
+
+	void SolLuaErrors::Install(sol::state_view& lua)
+	{
+		if (sol::protected_function::get_default_handler(lua.lua_state()).valid())
+			return;
+
+		sol::protected_function::set_default_handler(sol::make_object(lua, &SolLuaErrors::MessageHandler));
+	}
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "RmlSolLua/RmlSolLua.h"
+
+#include <sol/sol.hpp>
+
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Deduplicates Lua errors by the chunk and line they were raised at.
+	/// The first error from a place is logged with a traceback.  Repeats are counted and logged as one summary per interval.
+	/// Errors without a position are keyed by their first line.  At most MaxEntries places are kept; the one with the fewest errors makes room for a new one.
+	/// </summary>
+	class SolLuaErrors
+	{
+	public:
+		/// <summary>
+		/// Reports an error through the callback, or the log.
+		/// </summary>
+		static void Report(const Rml::String& message);
+
+		/// <summary>
+		/// Logs the summaries of repeated errors whose interval has passed.  Cheap when there are none.
+		/// </summary>
+		static void Tick();
+
+		/// <param name="summary_interval">Seconds between summaries of an error that keeps repeating.</param>
+		/// <param name="max_new_per_second">Errors from new places logged per second.  Others are only counted.  0 for no limit.</param>
+		static void Configure(double summary_interval, int max_new_per_second);
+
+		static void SetCallback(ErrorCallback callback);
+
+		static Rml::Vector<ErrorStats> GetStats();
+
+		static void Reset();
+
+		/// <summary>
+		/// Message handler for protected calls.  Adds a traceback to errors from places that haven't failed before.
+		/// </summary>
+		static int MessageHandler(lua_State* L);
+
+		/// <summary>
+		/// Makes MessageHandler the default handler of sol protected functions, unless the host set one.
+		/// </summary>
+		static void Install(sol::state_view& lua);
+	};
+
+} // end namespace Rml::SolLua
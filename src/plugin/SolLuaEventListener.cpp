@@ -1,6 +1,9 @@
 #include "SolLuaEventListener.h"
 
+#include "plugin/SolLuaCallScope.h"
 #include "plugin/SolLuaDocument.h"
+#include "plugin/SolLuaLatency.h"
+#include "plugin/SolLuaWatchdog.h"
 
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/Log.h>
@@ -14,47 +17,85 @@
 namespace Rml::SolLua
 {
 
-	SolLuaEventListener::SolLuaEventListener(sol::state_view& lua, const Rml::String& code, Rml::Element* element)
-		: m_element(element)
+	namespace
 	{
-		if (element == nullptr)
-			return;
-
-		auto* context = element->GetContext();
-		auto* document = element->GetOwnerDocument();
-
-		// Wrap our code so we pass event, element, and document.
-		//auto f = std::format("return function (event,element,document) {} end", code);
-		Rml::String f{ "--" };
-		if (context != nullptr)
+		// Live listeners by the document that owned their element when they were created, so a document releases only its own.
+		// Listeners created on elements without a document are kept under nullptr.
+		Rml::UnorderedMap<const Rml::ElementDocument*, Rml::UnorderedSet<SolLuaEventListener*>>& getListeners()
 		{
-			f.append("[");
-			f.append(context->GetName());
-			f.append("]");
+			static Rml::UnorderedMap<const Rml::ElementDocument*, Rml::UnorderedSet<SolLuaEventListener*>> listeners;
+			return listeners;
 		}
-		if (document != nullptr)
+
+		std::size_t& getLiveCount()
 		{
-			f.append("[");
-			f.append(document->GetSourceURL());
-			f.append("]");
+			static std::size_t count = 0;
+			return count;
 		}
 
-		if (f.size() != 2)
-			f.append(" ");
-
-		f.append(element->GetTagName());
-		if (const auto& id = element->GetId(); !id.empty())
+		Rml::ElementDocument* getOwnerDocument(Rml::Element* element)
 		{
-			f.append("#");
-			f.append(id);
+			return element != nullptr ? element->GetOwnerDocument() : nullptr;
 		}
-		if (auto classes = element->GetClassNames(); !classes.empty())
+
+		/// <summary>
+		/// Builds the "[context][document] tag#id.class" label that identifies a listener in chunk names and stats.
+		/// </summary>
+		Rml::String makeLabel(Rml::Element* element)
 		{
-			f.append(".");
-			std::replace(classes.begin(), classes.end(), ' ', '.');
-			f.append(classes);
+			auto* context = element->GetContext();
+			auto* document = element->GetOwnerDocument();
+
+			Rml::String label;
+			if (context != nullptr)
+			{
+				label.append("[");
+				label.append(context->GetName());
+				label.append("]");
+			}
+			if (document != nullptr)
+			{
+				label.append("[");
+				label.append(document->GetSourceURL());
+				label.append("]");
+			}
+
+			if (!label.empty())
+				label.append(" ");
+
+			label.append(element->GetTagName());
+			if (const auto& id = element->GetId(); !id.empty())
+			{
+				label.append("#");
+				label.append(id);
+			}
+			if (auto classes = element->GetClassNames(); !classes.empty())
+			{
+				label.append(".");
+				std::replace(classes.begin(), classes.end(), ' ', '.');
+				label.append(classes);
+			}
+
+			return label;
 		}
+	}
 
+	SolLuaEventListener::SolLuaEventListener(sol::state_view& lua, const Rml::String& code, Rml::Element* element)
+		: m_element(element), m_document(getOwnerDocument(element))
+	{
+		getListeners()[m_document].insert(this);
+		++getLiveCount();
+
+		if (element == nullptr)
+			return;
+
+		auto* document = m_document;
+		m_label = makeLabel(element);
+
+		// Wrap our code so we pass event, element, and document.
+		//auto f = std::format("return function (event,element,document) {} end", code);
+		Rml::String f{ "--" };
+		f.append(m_label);
 		f.append("\n");
 		f.append("return function (event,element,document) ");
 		f.append(code);
@@ -63,6 +104,8 @@ namespace Rml::SolLua
 		// Run the script and get our function to call.
 		// We would have liked to call SolLuaDocument::RunLuaScript, but we don't know our owner_document at this point!
 		// Just get the function now.  When we process the event, we will move it to the environment.
+		// The closure is charged to the document that owns the element.
+		SolLuaCallScope scope{ SolLuaStats::CallType::Script, document };
 		auto result = lua.safe_script(f, ErrorHandler);
 		if (result.valid())
 		{
@@ -71,6 +114,8 @@ namespace Rml::SolLua
 			{
 				auto func = obj.as<sol::protected_function>();
 				m_func = func;
+				m_compiled = true;
+				++SolLuaStats::Get().CompiledListeners;
 			}
 			else
 			{
@@ -80,8 +125,25 @@ namespace Rml::SolLua
 	}
 
 	SolLuaEventListener::SolLuaEventListener(sol::protected_function func, Rml::Element* element)
-		: m_func(func), m_element(element)
+		: m_func(func), m_element(element), m_document(getOwnerDocument(element))
+	{
+		getListeners()[m_document].insert(this);
+		++getLiveCount();
+	}
+
+	SolLuaEventListener::~SolLuaEventListener()
 	{
+		ReleaseFunction();
+		SolLuaLatency::Forget(&m_label);
+
+		auto& listeners = getListeners();
+		if (auto it = listeners.find(m_document); it != listeners.end())
+		{
+			it->second.erase(this);
+			if (it->second.empty())
+				listeners.erase(it);
+		}
+		--getLiveCount();
 	}
 
 	void SolLuaEventListener::OnDetach(Rml::Element* element)
@@ -89,6 +151,41 @@ namespace Rml::SolLua
 		delete this;
 	}
 
+	void SolLuaEventListener::ReleaseDocument(Rml::ElementDocument* document)
+	{
+		auto& listeners = getListeners();
+		if (auto it = listeners.find(document); it != listeners.end())
+		{
+			for (auto listener : it->second)
+				listener->ReleaseFunction();
+		}
+
+		// Elements that joined a document after their listener was created.
+		if (auto it = listeners.find(nullptr); it != listeners.end())
+		{
+			for (auto listener : it->second)
+			{
+				if (getOwnerDocument(listener->m_element) == document)
+					listener->ReleaseFunction();
+			}
+		}
+	}
+
+	void SolLuaEventListener::ReleaseFunction()
+	{
+		m_func = sol::protected_function{};
+		if (m_compiled)
+		{
+			m_compiled = false;
+			--SolLuaStats::Get().CompiledListeners;
+		}
+	}
+
+	std::size_t SolLuaEventListener::GetLiveCount()
+	{
+		return getLiveCount();
+	}
+
 	void SolLuaEventListener::ProcessEvent(Rml::Event& event)
 	{
 		if (!m_func.valid())
@@ -108,10 +205,26 @@ namespace Rml::SolLua
 				env.set(ident, document->GetId());
 		}
 
+		// Listeners added from Lua with a function only get their label once it is needed.
+		if (m_label.empty() && (SolLuaCallScope::IsTiming() || SolLuaWatchdog::IsEnabled()) && m_element != nullptr)
+			m_label = makeLabel(m_element);
+
 		// Call the event!
+		SolLuaCallScope scope{ SolLuaStats::CallType::Listener, document, &m_label };
+		SolLuaWatchdog::Scope watchdog{ m_func.lua_state(), &m_label };
 		auto result = m_func.call(event, m_element, document);
 		if (!result.valid())
 			ErrorHandler(m_func.lua_state(), std::move(result));
+
+		if (watchdog.Tripped())
+		{
+			const int disable_after = SolLuaWatchdog::GetDisableAfter();
+			if (disable_after > 0 && ++m_overruns >= disable_after)
+			{
+				Log::Message(Log::LT_WARNING, "[LUA][WATCHDOG] Disabling %s after %d budget overruns.", m_label.c_str(), m_overruns);
+				ReleaseFunction();
+			}
+		}
 	}
 
 } // namespace Rml::SolLua
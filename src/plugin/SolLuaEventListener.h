@@ -18,13 +18,34 @@ namespace Rml::SolLua
     public:
         SolLuaEventListener(sol::state_view& lua, const Rml::String& code, Rml::Element* element);
         SolLuaEventListener(sol::protected_function func, Rml::Element* element);
+        ~SolLuaEventListener();
 
         void OnDetach(Rml::Element* element) override;
         void ProcessEvent(Rml::Event& event) override;
 
+        /// <summary>
+        /// Releases the Lua functions of every listener on the elements of a document.
+        /// </summary>
+        /// <param name="document">The document being unloaded.</param>
+        static void ReleaseDocument(Rml::ElementDocument* document);
+
+        /// <summary>
+        /// Gets the number of live listeners.
+        /// </summary>
+        static std::size_t GetLiveCount();
+
     private:
         sol::protected_function m_func;
         Rml::Element* m_element;
+        Rml::ElementDocument* m_document;
+        Rml::String m_label;
+        int m_overruns = 0;
+        bool m_compiled = false;
+
+        /// <summary>
+        /// Drops the Lua function, and the listener from the compiled listener count.
+        /// </summary>
+        void ReleaseFunction();
     };
 
 } // namespace Rml::SolLua
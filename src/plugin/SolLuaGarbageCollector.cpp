@@ -0,0 +1,129 @@
+#include "SolLuaGarbageCollector.h"
+
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/SystemInterface.h>
+
+#include <algorithm>
+#include <chrono>
+
+
+namespace Rml::SolLua
+{
+
+	namespace
+	{
+		// Keyed by the main thread, so coroutines find the collector of their state.
+		Rml::UnorderedMap<lua_State*, Rml::UniquePtr<SolLuaGarbageCollector>>& getCollectors()
+		{
+			static Rml::UnorderedMap<lua_State*, Rml::UniquePtr<SolLuaGarbageCollector>> collectors;
+			return collectors;
+		}
+
+		int getMemoryKB(lua_State* L)
+		{
+			return lua_gc(L, LUA_GCCOUNT, 0);
+		}
+	}
+
+	SolLuaGarbageCollector* SolLuaGarbageCollector::Enable(lua_State* L, double budget_ms)
+	{
+		L = sol::main_thread(L, L);
+
+		auto& collector = getCollectors()[L];
+		if (!collector)
+		{
+			collector = Rml::MakeUnique<SolLuaGarbageCollector>(L);
+			collector->m_baseline_kb = getMemoryKB(L);
+			lua_gc(L, LUA_GCSTOP, 0);
+		}
+		collector->SetBudget(budget_ms);
+		return collector.get();
+	}
+
+	void SolLuaGarbageCollector::Disable(lua_State* L)
+	{
+		L = sol::main_thread(L, L);
+
+		if (getCollectors().erase(L) != 0)
+			lua_gc(L, LUA_GCRESTART, 0);
+	}
+
+	SolLuaGarbageCollector* SolLuaGarbageCollector::Get(lua_State* L)
+	{
+		auto& collectors = getCollectors();
+		if (collectors.empty())
+			return nullptr;
+
+		auto it = collectors.find(sol::main_thread(L, L));
+		return it != collectors.end() ? it->second.get() : nullptr;
+	}
+
+	void SolLuaGarbageCollector::StepContext(const Rml::Context* context)
+	{
+		auto system = Rml::GetSystemInterface();
+		const double time = system != nullptr ? system->GetElapsedTime() : 0.0;
+
+		const bool new_frame = m_frame_context == nullptr || context == m_frame_context;
+		const bool overdue = time < m_frame_time || time - m_frame_time >= MaxFrameGap;
+		if (!new_frame && !overdue)
+			return;
+
+		m_frame_context = context;
+		m_frame_time = time;
+		Step();
+	}
+
+	void SolLuaGarbageCollector::Step()
+	{
+		using clock = std::chrono::steady_clock;
+		const auto start = clock::now();
+		const auto budget = std::chrono::duration<double, std::milli>(m_budget_ms);
+
+		++m_stats.Frames;
+
+		const auto memory_kb = getMemoryKB(m_state);
+		if (m_baseline_kb > 0 && memory_kb > m_baseline_kb * FullCollectLimit)
+		{
+			// Stepping can't keep up: collect everything now rather than let memory run away.
+			lua_gc(m_state, LUA_GCCOLLECT, 0);
+			++m_stats.FullCollections;
+			++m_stats.Cycles;
+			m_baseline_kb = getMemoryKB(m_state);
+		}
+		else
+		{
+			// Take bigger steps while memory grows faster than frames can collect it.
+			if (m_baseline_kb > 0 && memory_kb > m_baseline_kb * GrowthLimit)
+				m_step_size_kb = std::min(m_step_size_kb * 2, MaxStepSizeKB);
+
+			bool finished = false;
+			while (!finished && clock::now() - start < budget)
+			{
+				++m_stats.Steps;
+				finished = lua_gc(m_state, LUA_GCSTEP, m_step_size_kb) != 0;
+			}
+
+			if (finished)
+			{
+				++m_stats.Cycles;
+				m_baseline_kb = getMemoryKB(m_state);
+
+				// A cycle that fits in one frame can use smaller steps, which pause for less.
+				m_step_size_kb = std::max(m_step_size_kb / 2, MinStepSizeKB);
+			}
+		}
+
+#if LUA_VERSION_NUM < 502
+		// Lua 5.1 and LuaJIT reset the collection threshold after a step or a full collection, which restarts automatic collection.
+		lua_gc(m_state, LUA_GCSTOP, 0);
+#endif
+
+		const double pause = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+		m_stats.LastPauseMs = pause;
+		m_stats.MaxPauseMs = std::max(m_stats.MaxPauseMs, pause);
+		m_stats.TotalPauseMs += pause;
+		m_stats.StepSizeKB = m_step_size_kb;
+		m_stats.MemoryKB = getMemoryKB(m_state);
+	}
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <RmlUi/Core/Types.h>
+
+#include <sol/sol.hpp>
+
+#include <cstddef>
+
+
+namespace Rml
+{
+	class Context;
+}
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Managed garbage collection: automatic collection is stopped and the collector is stepped once per frame within a time budget.
+	/// </summary>
+	class SolLuaGarbageCollector
+	{
+	public:
+		struct Stats
+		{
+			std::size_t Frames = 0;
+			std::size_t Steps = 0;
+			std::size_t Cycles = 0;
+			std::size_t FullCollections = 0;
+			double LastPauseMs = 0.0;
+			double MaxPauseMs = 0.0;
+			double TotalPauseMs = 0.0;
+			int StepSizeKB = 0;
+			int MemoryKB = 0;
+		};
+
+		/// <summary>
+		/// Enables managed collection on a state, or changes the budget if already enabled.
+		/// </summary>
+		/// <param name="L">The Lua state.</param>
+		/// <param name="budget_ms">Time to spend collecting each frame, in milliseconds.</param>
+		/// <returns>The collector.</returns>
+		static SolLuaGarbageCollector* Enable(lua_State* L, double budget_ms);
+
+		/// <summary>
+		/// Restores automatic collection on a state.
+		/// </summary>
+		/// <param name="L">The Lua state.</param>
+		static void Disable(lua_State* L);
+
+		/// <summary>
+		/// Gets the collector of a state.
+		/// </summary>
+		/// <param name="L">The Lua state.</param>
+		/// <returns>The collector, or nullptr if managed collection is off.</returns>
+		static SolLuaGarbageCollector* Get(lua_State* L);
+
+		explicit SolLuaGarbageCollector(lua_State* L) : m_state(L) {}
+
+		/// <summary>
+		/// Runs collection steps until the frame budget is spent or a cycle completes.
+		/// </summary>
+		void Step();
+
+		/// <summary>
+		/// Steps for Context:Update called from Lua, once per frame when several contexts are updated.
+		/// The context that stepped last starts each frame.  Any context steps if none did for MaxFrameGap seconds,
+		/// such as when that context was destroyed or is now updated from C++.
+		/// </summary>
+		/// <param name="context">The context being updated.</param>
+		void StepContext(const Rml::Context* context);
+
+		void SetBudget(double budget_ms) { m_budget_ms = budget_ms; }
+		double GetBudget() const { return m_budget_ms; }
+		const Stats& GetStats() const { return m_stats; }
+
+	private:
+		static constexpr int MinStepSizeKB = 4;
+		static constexpr int MaxStepSizeKB = 1024;
+
+		// Memory growing past these multiples of the size after the last cycle makes steps bigger, then forces a full collection.
+		static constexpr double GrowthLimit = 2.0;
+		static constexpr double FullCollectLimit = 4.0;
+
+		static constexpr double MaxFrameGap = 0.1;
+
+		lua_State* m_state;
+		double m_budget_ms = 1.0;
+		int m_step_size_kb = MinStepSizeKB;
+		int m_baseline_kb = 0;
+		const Rml::Context* m_frame_context = nullptr;
+		double m_frame_time = 0.0;
+		Stats m_stats;
+	};
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,77 @@
+#include "SolLuaHooks.h"
+
+#include <RmlUi/Core/Types.h>
+
+#include <array>
+
+
+namespace Rml::SolLua
+{
+
+	namespace
+	{
+		using Handlers = std::array<SolLuaHooks::Handler, static_cast<int>(SolLuaHooks::Client::Count)>;
+
+		// Keyed by the main thread, so coroutines dispatch to the handlers of their state.
+		Rml::UnorderedMap<lua_State*, Handlers>& getHandlers()
+		{
+			static Rml::UnorderedMap<lua_State*, Handlers> handlers;
+			return handlers;
+		}
+	}
+
+	void SolLuaHooks::Set(lua_State* L, Client client, Handler handler)
+	{
+		auto main = sol::main_thread(L, L);
+		auto& handlers = getHandlers()[main];
+		handlers[static_cast<int>(client)] = handler;
+
+		// Coroutines created from here on copy the hook of the thread creating them.
+		lua_sethook(main, &SolLuaHooks::Dispatch, LUA_MASKCOUNT, Interval);
+		if (L != main)
+			lua_sethook(L, &SolLuaHooks::Dispatch, LUA_MASKCOUNT, Interval);
+	}
+
+	void SolLuaHooks::Clear(lua_State* L, Client client)
+	{
+		auto main = sol::main_thread(L, L);
+		auto& map = getHandlers();
+		auto iter = map.find(main);
+		if (iter == map.end())
+			return;
+
+		auto& handlers = iter->second;
+		handlers[static_cast<int>(client)] = nullptr;
+		for (auto handler : handlers)
+		{
+			if (handler != nullptr)
+				return;
+		}
+
+		// Coroutines that copied the hook remove it the next time it runs.
+		map.erase(iter);
+		lua_sethook(main, nullptr, 0, 0);
+		if (L != main)
+			lua_sethook(L, nullptr, 0, 0);
+	}
+
+	void SolLuaHooks::Dispatch(lua_State* L, lua_Debug* ar)
+	{
+		auto& map = getHandlers();
+		auto iter = map.find(sol::main_thread(L, L));
+		if (iter == map.end())
+		{
+			lua_sethook(L, nullptr, 0, 0);
+			return;
+		}
+
+		// Copy, as a handler may set or clear handlers.
+		const Handlers handlers = iter->second;
+		for (auto handler : handlers)
+		{
+			if (handler != nullptr)
+				handler(L, ar);
+		}
+	}
+
+} // end namespace Rml::SolLua
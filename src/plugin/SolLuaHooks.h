@@ -0,0 +1,43 @@
+#pragma once
+
+#include <sol/sol.hpp>
+
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Shares the count hook of a Lua state between the profiler and the watchdog, since Lua keeps one hook per thread.
+	/// The hook is installed while any client needs it and calls the handlers in client order.
+	/// Handlers are set per state: coroutines created while the hook is installed copy it and call the same handlers,
+	/// but coroutines created before run without it.
+	/// </summary>
+	class SolLuaHooks
+	{
+	public:
+		using Handler = void (*)(lua_State* L, lua_Debug* ar);
+
+		enum class Client
+		{
+			Profiler,
+			Watchdog,	// Last, as it may raise an error.
+			Count
+		};
+
+		// Instructions between calls of the handlers.
+		static constexpr int Interval = 1000;
+
+		/// <summary>
+		/// Sets the handler of a client and installs the hook.
+		/// </summary>
+		static void Set(lua_State* L, Client client, Handler handler);
+
+		/// <summary>
+		/// Removes the handler of a client, and the hook once no client needs it.
+		/// </summary>
+		static void Clear(lua_State* L, Client client);
+
+	private:
+		static void Dispatch(lua_State* L, lua_Debug* ar);
+	};
+
+} // end namespace Rml::SolLua
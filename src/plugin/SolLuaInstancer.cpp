@@ -3,12 +3,15 @@
 #include "SolLuaDocument.h"
 #include "SolLuaEventListener.h"
 
+#include "bind/bind.h"
+
 
 namespace Rml::SolLua
 {
 
 	ElementPtr SolLuaDocumentElementInstancer::InstanceElement(Element* parent, const String& tag, const XMLAttributes& attributes)
 	{
+		ensureCoreRegistered(m_state);
 		return ElementPtr(new SolLuaDocument(m_state, tag, m_lua_env_identifier));
 	}
 
@@ -20,6 +23,7 @@ namespace Rml::SolLua
 
 	EventListener* SolLuaEventListenerInstancer::InstanceEventListener(const String& value, Element* element)
 	{
+		ensureCoreRegistered(m_state);
 		return new SolLuaEventListener(m_state, value, element);
 	}
 
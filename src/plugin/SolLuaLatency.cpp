@@ -0,0 +1,136 @@
+#include "SolLuaLatency.h"
+
+#include <RmlUi/Core/Log.h>
+
+#include <algorithm>
+#include <chrono>
+
+
+namespace Rml::SolLua
+{
+
+	bool SolLuaLatency::s_enabled = false;
+	double SolLuaLatency::s_slow_threshold_ms = 0.0;
+
+	namespace
+	{
+		// By identity, then label.  Entry points without an identity share the nullptr entry.
+		Rml::UnorderedMap<const void*, Rml::UnorderedMap<Rml::String, LatencyStats>>& getHistograms()
+		{
+			static Rml::UnorderedMap<const void*, Rml::UnorderedMap<Rml::String, LatencyStats>> histograms;
+			return histograms;
+		}
+
+		struct SlowLog
+		{
+			std::chrono::steady_clock::time_point WindowStart;
+			int Logged = 0;
+			int Suppressed = 0;
+		};
+
+		int getBucket(double ms)
+		{
+			const auto us = static_cast<uint64_t>(ms * 1000.0);
+			int bucket = 0;
+			while (bucket < LatencyStats::BucketCount - 1 && us >= (uint64_t{ 1 } << (bucket + 1)))
+				++bucket;
+			return bucket;
+		}
+	}
+
+	void SolLuaLatency::Enable(bool enabled, double slow_threshold_ms)
+	{
+		s_enabled = enabled;
+		s_slow_threshold_ms = slow_threshold_ms;
+	}
+
+	void SolLuaLatency::Record(const Rml::String& label, const void* identity, double ms)
+	{
+		auto& stats = getHistograms()[identity][label];
+		if (stats.Count == 0)
+			stats.Label = label;
+
+		++stats.Count;
+		stats.TotalMs += ms;
+		stats.MaxMs = std::max(stats.MaxMs, ms);
+		++stats.Buckets[getBucket(ms)];
+
+		if (s_slow_threshold_ms > 0.0 && ms > s_slow_threshold_ms)
+		{
+			++stats.Slow;
+
+			static SlowLog log;
+			const auto now = std::chrono::steady_clock::now();
+			if (now - log.WindowStart >= std::chrono::seconds(1))
+			{
+				log.WindowStart = now;
+				log.Logged = 0;
+			}
+
+			if (log.Logged >= MaxSlowLogs)
+			{
+				++log.Suppressed;
+				return;
+			}
+
+			++log.Logged;
+			if (log.Suppressed > 0)
+			{
+				Rml::Log::Message(Rml::Log::LT_WARNING, "[LUA][SLOW] %s took %.2f ms (%d more slow calls not logged)", label.c_str(), ms, log.Suppressed);
+				log.Suppressed = 0;
+			}
+			else
+			{
+				Rml::Log::Message(Rml::Log::LT_WARNING, "[LUA][SLOW] %s took %.2f ms", label.c_str(), ms);
+			}
+		}
+	}
+
+	void SolLuaLatency::Forget(const void* identity)
+	{
+		auto& histograms = getHistograms();
+		if (identity == nullptr || histograms.empty())
+			return;
+
+		auto iter = histograms.find(identity);
+		if (iter == histograms.end())
+			return;
+
+		auto labels = std::move(iter->second);
+		histograms.erase(iter);
+
+		auto& merged = histograms[nullptr];
+		for (auto& [label, stats] : labels)
+		{
+			auto& target = merged[label];
+			if (target.Count == 0)
+				target.Label = label;
+
+			target.Count += stats.Count;
+			target.TotalMs += stats.TotalMs;
+			target.MaxMs = std::max(target.MaxMs, stats.MaxMs);
+			target.Slow += stats.Slow;
+			for (int i = 0; i < LatencyStats::BucketCount; ++i)
+				target.Buckets[i] += stats.Buckets[i];
+		}
+	}
+
+	Rml::Vector<LatencyStats> SolLuaLatency::GetStats()
+	{
+		Rml::Vector<LatencyStats> result;
+		for (const auto& [identity, labels] : getHistograms())
+		{
+			for (const auto& [label, stats] : labels)
+				result.push_back(stats);
+		}
+
+		std::sort(result.begin(), result.end(), [](const LatencyStats& a, const LatencyStats& b) { return a.TotalMs > b.TotalMs; });
+		return result;
+	}
+
+	void SolLuaLatency::Reset()
+	{
+		getHistograms().clear();
+	}
+
+} // end namespace Rml::SolLua
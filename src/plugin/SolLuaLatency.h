@@ -0,0 +1,59 @@
+#pragma once
+
+#include "RmlSolLua/RmlSolLua.h"
+
+#include <RmlUi/Core/Types.h>
+
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Latency histograms of Lua entry points, keyed by the label given to SolLuaCallScope and, for listeners, the listener.
+	/// Off by default; when off, scopes don't read the clock.
+	/// </summary>
+	class SolLuaLatency
+	{
+	public:
+		static bool IsEnabled() { return s_enabled; }
+
+		/// <summary>
+		/// Turns recording on or off.
+		/// </summary>
+		/// <param name="enabled">Whether to record.</param>
+		/// <param name="slow_threshold_ms">Calls taking longer than this are logged as warnings.  0 disables the log.</param>
+		static void Enable(bool enabled, double slow_threshold_ms);
+
+		/// <summary>
+		/// Adds one call to the histogram of an entry point.
+		/// </summary>
+		/// <param name="label">The entry point label.</param>
+		/// <param name="identity">Separates entry points sharing a label, such as listeners on elements with the same tag and classes.  nullptr merges calls by label.</param>
+		/// <param name="ms">Duration of the call in milliseconds.</param>
+		static void Record(const Rml::String& label, const void* identity, double ms);
+
+		/// <summary>
+		/// Folds the histograms of an entry point that is going away into those of its label,
+		/// so a new entry point at the same address starts empty and the histograms don't grow with every listener created.
+		/// </summary>
+		/// <param name="identity">The identity passed to Record.</param>
+		static void Forget(const void* identity);
+
+		/// <summary>
+		/// Gets the stats of every label, slowest total first.
+		/// </summary>
+		static Rml::Vector<LatencyStats> GetStats();
+
+		/// <summary>
+		/// Clears every histogram.
+		/// </summary>
+		static void Reset();
+
+	private:
+		static bool s_enabled;
+		static double s_slow_threshold_ms;
+
+		// At most MaxSlowLogs warnings are logged per second; the rest are counted and reported with the next one.
+		static constexpr int MaxSlowLogs = 10;
+	};
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,123 @@
+#include "SolLuaLog.h"
+
+#include "bind/bind.h"
+
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/SystemInterface.h>
+
+
+namespace Rml::SolLua
+{
+
+	Rml::Log::Type SolLuaLog::s_level = Rml::Log::LT_MAX;
+	bool SolLuaLog::s_batching = false;
+
+	namespace
+	{
+		// A batch this large is flushed early, so a host that never flushes doesn't grow it forever.
+		constexpr std::size_t MaxBatchSize = 64 * 1024;
+
+		struct Batch
+		{
+			Rml::Log::Type type = Rml::Log::LT_INFO;
+			Rml::String text;
+		};
+
+		Batch& getBatch()
+		{
+			thread_local Batch batch;
+			return batch;
+		}
+
+		void output(Rml::Log::Type type, const Rml::String& message)
+		{
+			// Straight to the system interface: Log::Message formats again and truncates long messages.
+			if (auto system = Rml::GetSystemInterface(); system != nullptr)
+				system->LogMessage(type, message);
+		}
+
+		/// <summary>
+		/// Formats the arguments from first to the top of the stack into a buffer.
+		/// A __tostring metamethod may print while an outer call is formatting, so each call borrows its own Scratch buffer.
+		/// </summary>
+		/// <returns>The buffer.</returns>
+		const Rml::String& format(lua_State* L, int first, Rml::String& buffer)
+		{
+			buffer.clear();
+
+			const int top = lua_gettop(L);
+			for (int i = first; i <= top; ++i)
+			{
+				if (i > first)
+					buffer.push_back('\t');
+
+				std::size_t length = 0;
+				const char* str = luaL_tolstring(L, i, &length);
+				buffer.append(str, length);
+				lua_pop(L, 1);
+			}
+			return buffer;
+		}
+	}
+
+	void SolLuaLog::SetBatching(bool enabled)
+	{
+		if (!enabled)
+			Flush();
+		s_batching = enabled;
+	}
+
+	void SolLuaLog::Flush()
+	{
+		auto& batch = getBatch();
+		if (batch.text.empty())
+			return;
+
+		output(batch.type, batch.text);
+		batch.text.clear();
+	}
+
+	int SolLuaLog::Print(lua_State* L)
+	{
+		if (IsEnabled(Rml::Log::LT_INFO))
+		{
+			Scratch<Rml::String> buffer;
+			Write(Rml::Log::LT_INFO, format(L, 1, *buffer));
+		}
+		return 0;
+	}
+
+	int SolLuaLog::Message(lua_State* L)
+	{
+		const auto type = static_cast<Rml::Log::Type>(luaL_checkinteger(L, 1));
+		if (IsEnabled(type))
+		{
+			Scratch<Rml::String> buffer;
+			Write(type, format(L, 2, *buffer));
+		}
+		return 0;
+	}
+
+	void SolLuaLog::Write(Rml::Log::Type type, const Rml::String& message)
+	{
+		if (!s_batching)
+		{
+			output(type, message);
+			return;
+		}
+
+		// One batch holds one type, so a change of type flushes.
+		auto& batch = getBatch();
+		if (!batch.text.empty() && batch.type != type)
+			Flush();
+
+		if (!batch.text.empty())
+			batch.text.push_back('\n');
+		batch.text.append(message);
+		batch.type = type;
+
+		if (batch.text.size() >= MaxBatchSize)
+			Flush();
+	}
+
+} // end namespace Rml::SolLua
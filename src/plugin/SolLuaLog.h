@@ -0,0 +1,51 @@
+#pragma once
+
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Types.h>
+
+#include <sol/sol.hpp>
+
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Native print and Log.Message.
+	/// Messages below the level are dropped before any string work, and the rest are formatted into reusable thread local buffers, one per nested call.
+	/// With batching on, messages are joined and handed to the system interface once per frame instead of once per call.
+	/// </summary>
+	class SolLuaLog
+	{
+	public:
+		/// <summary>
+		/// Sets the least important type that is logged.  Defaults to LT_MAX, which logs everything.
+		/// </summary>
+		static void SetLevel(Rml::Log::Type level) { s_level = level; }
+		static Rml::Log::Type GetLevel() { return s_level; }
+
+		static bool IsEnabled(Rml::Log::Type type) { return type <= s_level; }
+
+		static void SetBatching(bool enabled);
+
+		/// <summary>
+		/// Hands the batched messages of this thread to the system interface.
+		/// </summary>
+		static void Flush();
+
+		/// <summary>
+		/// print(...): writes the arguments, converted like tostring and separated by tabs, as an info message.
+		/// </summary>
+		static int Print(lua_State* L);
+
+		/// <summary>
+		/// Log.Message(type, ...): writes the arguments like print, with a type.
+		/// </summary>
+		static int Message(lua_State* L);
+
+	private:
+		static void Write(Rml::Log::Type type, const Rml::String& message);
+
+		static Rml::Log::Type s_level;
+		static bool s_batching;
+	};
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,246 @@
+#include "SolLuaModules.h"
+
+#include "RmlSolLua/RmlSolLuaBundle.h"
+
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/FileInterface.h>
+
+#include <algorithm>
+#include <cstdint>
+
+
+namespace Rml::SolLua
+{
+
+	namespace
+	{
+		// Registry flag set once the searcher is installed in a state.
+		constexpr const char* RegistryKey = "RmlSolLua.searcher";
+
+		struct Chunk
+		{
+			// Of the source the bytecode was compiled from.
+			uint64_t hash = 0;
+			std::size_t size = 0;
+			Rml::String bytecode;
+		};
+
+		struct Cache
+		{
+			// By chunk name, so an edited file replaces its old bytecode.
+			Rml::UnorderedMap<Rml::String, Chunk> chunks;
+			Rml::StringList paths = { "?.lua", "?/init.lua" };
+			ChunkCacheStats stats;
+		};
+
+		Cache& getCache()
+		{
+			static Cache cache;
+			return cache;
+		}
+
+		uint64_t hash(std::string_view data)
+		{
+			// FNV-1a.
+			uint64_t h = 14695981039346656037ull;
+			for (const char c : data)
+			{
+				h ^= static_cast<unsigned char>(c);
+				h *= 1099511628211ull;
+			}
+			return h;
+		}
+
+		int writer(lua_State*, const void* p, size_t size, void* ud)
+		{
+			static_cast<Rml::String*>(ud)->append(static_cast<const char*>(p), size);
+			return 0;
+		}
+
+		Rml::String dump(lua_State* L)
+		{
+			Rml::String bytecode;
+			// Keep debug info, so errors still name lines.
+#if LUA_VERSION_NUM >= 503
+			lua_dump(L, &writer, &bytecode, 0);
+#else
+			lua_dump(L, &writer, &bytecode);
+#endif
+			return bytecode;
+		}
+
+		/// <summary>
+		/// Finds and loads a module.  Never raises errors, so no C++ object is skipped by a longjmp.
+		/// </summary>
+		/// <returns>The number of values pushed for the searcher to return, or -1 with an error message pushed.</returns>
+		int search(lua_State* L, const char* name)
+		{
+			Rml::String module{ name };
+			std::replace(module.begin(), module.end(), '.', '/');
+
+			Rml::String tried;
+			Rml::String buffer;
+			std::string_view source;
+			bool bytecode = false;
+			for (const auto& pattern : getCache().paths)
+			{
+				Rml::String path;
+				for (const char c : pattern)
+				{
+					if (c == '?')
+						path.append(module);
+					else
+						path.push_back(c);
+				}
+
+				if (!SolLuaModules::ReadFile(path, buffer, source, bytecode))
+				{
+					tried.append("\n\tno file '");
+					tried.append(path);
+					tried.append("' (RmlUi)");
+					continue;
+				}
+
+				if (SolLuaModules::LoadChunk(L, source, "@" + path, bytecode) != 0)
+				{
+					lua_pushfstring(L, "error loading module '%s' from file '%s':\n\t%s", name, path.c_str(), lua_tostring(L, -1));
+					lua_remove(L, -2);
+					return -1;
+				}
+
+				// Lua 5.2+ passes the second value to the loader.
+				lua_pushstring(L, path.c_str());
+				return 2;
+			}
+
+			lua_pushstring(L, tried.c_str());
+			return 1;
+		}
+	}
+
+	bool SolLuaModules::ReadFile(const Rml::String& path, Rml::String& buffer, std::string_view& contents, bool& bytecode)
+	{
+		bytecode = false;
+
+		auto file_interface = Rml::GetFileInterface();
+		if (file_interface == nullptr)
+			return false;
+
+		if (auto bundle = dynamic_cast<BundleFileInterface*>(file_interface); bundle != nullptr && bundle->Find(path, contents, &bytecode))
+			return true;
+
+		auto handle = file_interface->Open(path);
+		if (handle == 0)
+			return false;
+
+		buffer.resize(file_interface->Length(handle));
+		buffer.resize(file_interface->Read(buffer.data(), buffer.size(), handle));
+		file_interface->Close(handle);
+		contents = buffer;
+		return true;
+	}
+
+	int SolLuaModules::LoadChunk(lua_State* L, std::string_view source, const Rml::String& chunkname, bool bytecode)
+	{
+		// Bytecode from a bundle.  Lua checks its header.
+		if (bytecode)
+		{
+#if LUA_VERSION_NUM >= 502
+			return luaL_loadbufferx(L, source.data(), source.size(), chunkname.c_str(), "b");
+#else
+			return luaL_loadbuffer(L, source.data(), source.size(), chunkname.c_str());
+#endif
+		}
+
+		auto& cache = getCache();
+
+		const auto source_hash = hash(source);
+		auto iter = cache.chunks.find(chunkname);
+		if (iter != cache.chunks.end() && iter->second.hash == source_hash && iter->second.size == source.size())
+		{
+			const auto& bytecode = iter->second.bytecode;
+			if (luaL_loadbuffer(L, bytecode.data(), bytecode.size(), chunkname.c_str()) == 0)
+			{
+				++cache.stats.Hits;
+				return 0;
+			}
+
+			// Only corrupt bytecode fails.  Compile and replace it.
+			lua_pop(L, 1);
+		}
+
+		++cache.stats.Misses;
+		const int status = luaL_loadbuffer(L, source.data(), source.size(), chunkname.c_str());
+		if (status != 0)
+			return status;
+
+		auto bytecode = dump(L);
+		if (bytecode.empty())
+			return 0;
+
+		if (iter == cache.chunks.end())
+			iter = cache.chunks.emplace(chunkname, Chunk()).first;
+		else
+			cache.stats.Bytes -= iter->second.bytecode.size();
+
+		cache.stats.Bytes += bytecode.size();
+		iter->second.hash = source_hash;
+		iter->second.size = source.size();
+		iter->second.bytecode = std::move(bytecode);
+		return 0;
+	}
+
+	void SolLuaModules::Install(sol::state_view& lua)
+	{
+		auto package = lua["package"].get<sol::optional<sol::table>>();
+		if (!package)
+			return;
+
+		auto registry = lua.registry();
+		if (registry.raw_get_or(RegistryKey, false))
+			return;
+
+		auto searchers = package->get<sol::optional<sol::table>>("searchers");
+		if (!searchers)
+			searchers = package->get<sol::optional<sol::table>>("loaders");
+		if (!searchers)
+			return;
+
+		// After the preload searcher, so package.preload still wins.
+		const auto count = static_cast<int>(searchers->size());
+		for (int i = count; i >= 2; --i)
+			searchers->raw_set(i + 1, searchers->raw_get<sol::object>(i));
+		searchers->raw_set(2, &SolLuaModules::Searcher);
+
+		registry.raw_set(RegistryKey, true);
+	}
+
+	void SolLuaModules::SetPaths(const Rml::StringList& patterns)
+	{
+		getCache().paths = patterns;
+	}
+
+	ChunkCacheStats SolLuaModules::GetStats()
+	{
+		auto& cache = getCache();
+		cache.stats.Entries = cache.chunks.size();
+		return cache.stats;
+	}
+
+	void SolLuaModules::Clear()
+	{
+		auto& cache = getCache();
+		cache.chunks.clear();
+		cache.stats = ChunkCacheStats{};
+	}
+
+	int SolLuaModules::Searcher(lua_State* L)
+	{
+		const char* name = luaL_checkstring(L, 1);
+		const int results = search(L, name);
+		if (results < 0)
+			return lua_error(L);
+		return results;
+	}
+
+} // end namespace Rml::SolLua
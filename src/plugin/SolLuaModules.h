@@ -0,0 +1,53 @@
+#pragma once
+
+#include "RmlSolLua/RmlSolLua.h"
+
+#include <sol/sol.hpp>
+
+#include <string_view>
+
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Loads Lua chunks through a cache of compiled bytecode, and resolves require() through the RmlUi file interface.
+	/// The cache holds one entry per chunk name with the hash of its source, so it outlives Lua states and an edited file replaces its entry when compiled again.
+	/// Like the rest of the library it expects Lua to run on one thread.
+	/// </summary>
+	class SolLuaModules
+	{
+	public:
+		/// <summary>
+		/// Reads a file through the RmlUi file interface.  Files in a mounted bundle are returned without a copy.
+		/// </summary>
+		/// <param name="buffer">Holds the contents of files that aren't bundled.</param>
+		/// <param name="contents">Set to the contents, valid while the buffer and the file interface live.</param>
+		/// <param name="bytecode">Set to whether the file is bytecode precompiled into a bundle.</param>
+		/// <returns>False if the file couldn't be opened.</returns>
+		static bool ReadFile(const Rml::String& path, Rml::String& buffer, std::string_view& contents, bool& bytecode);
+
+		/// <summary>
+		/// Compiles a chunk, or loads its cached bytecode.  Precompiled chunks are loaded as they are, without caching.
+		/// </summary>
+		/// <param name="bytecode">Whether the source is precompiled, as reported by ReadFile.</param>
+		/// <returns>0 with the function pushed, or a Lua error status with the message pushed.</returns>
+		static int LoadChunk(lua_State* L, std::string_view source, const Rml::String& chunkname, bool bytecode = false);
+
+		/// <summary>
+		/// Adds the searcher to package.searchers (package.loaders before Lua 5.2), after the preload searcher.
+		/// Does nothing if the package library isn't open.
+		/// </summary>
+		static void Install(sol::state_view& lua);
+
+		/// <param name="patterns">File interface paths where '?' is replaced by the module name with '.' turned into '/'.</param>
+		static void SetPaths(const Rml::StringList& patterns);
+
+		static ChunkCacheStats GetStats();
+
+		static void Clear();
+
+	private:
+		static int Searcher(lua_State* L);
+	};
+
+} // end namespace Rml::SolLua
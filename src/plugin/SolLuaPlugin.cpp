@@ -1,6 +1,10 @@
 ﻿#include "SolLuaPlugin.h"
 
+#include "SolLuaDocument.h"
+#include "SolLuaEventListener.h"
+#include "SolLuaGarbageCollector.h"
 #include "SolLuaInstancer.h"
+#include "SolLuaLog.h"
 
 #include "bind/bind.h"
 
@@ -21,7 +25,7 @@ namespace Rml::SolLua
 
 	int SolLuaPlugin::GetEventClasses()
 	{
-		return EVT_BASIC;
+		return EVT_BASIC | EVT_DOCUMENT;
 	}
 
 	void SolLuaPlugin::OnInitialise()
@@ -32,8 +36,20 @@ namespace Rml::SolLua
 		Factory::RegisterEventListenerInstancer(event_listener_instancer.get());
 	}
 
+	void SolLuaPlugin::OnDocumentUnload(ElementDocument* document)
+	{
+		// Drop Lua references now instead of whenever the document and its listeners get destroyed.
+		SolLuaEventListener::ReleaseDocument(document);
+		if (auto soldocument = rmlui_dynamic_cast<SolLuaDocument*>(document); soldocument != nullptr)
+			soldocument->ClearLuaEnvironment();
+	}
+
 	void SolLuaPlugin::OnShutdown()
 	{
+		SolLuaLog::Flush();
+
+		// The state may outlive the plugin, so hand collection back to Lua.
+		SolLuaGarbageCollector::Disable(m_lua_state.lua_state());
 		m_lua_state.collect_garbage();
 		delete this;
 	}
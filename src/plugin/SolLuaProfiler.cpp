@@ -0,0 +1,159 @@
+#include "SolLuaProfiler.h"
+
+#include "SolLuaCallScope.h"
+#include "SolLuaHooks.h"
+
+#include <RmlUi/Core/ElementDocument.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+
+namespace Rml::SolLua
+{
+
+	namespace
+	{
+		// Stacks deeper than this keep only the innermost frames.
+		constexpr int MaxDepth = 64;
+
+		struct Profile
+		{
+			lua_State* state = nullptr;
+			std::chrono::steady_clock::duration interval{};
+			std::chrono::steady_clock::time_point next_sample;
+			Rml::UnorderedMap<Rml::String, uint64_t> stacks;
+			Rml::String scratch;
+		};
+
+		Profile& getProfile()
+		{
+			static Profile profile;
+			return profile;
+		}
+
+		void appendFrame(Rml::String& out, const lua_Debug& ar)
+		{
+			// ';' and ' ' separate frames and counts in the collapsed format.
+			auto append = [&out](const char* str) {
+				for (; *str != '\0'; ++str)
+					out.push_back(*str == ';' || *str == ' ' ? '_' : *str);
+			};
+
+			if (std::strcmp(ar.what, "C") == 0)
+			{
+				append(ar.name != nullptr ? ar.name : "[C]");
+				return;
+			}
+
+			if (std::strcmp(ar.what, "main") == 0)
+				append("main");
+			else
+				append(ar.name != nullptr ? ar.name : "?");
+
+			out.push_back('(');
+			append(ar.short_src);
+			out.push_back(':');
+			out.append(std::to_string(ar.linedefined));
+			out.push_back(')');
+		}
+	}
+
+	void SolLuaProfiler::Start(lua_State* L, int hz)
+	{
+		auto& profile = getProfile();
+		if (profile.state != nullptr)
+			SolLuaHooks::Clear(profile.state, SolLuaHooks::Client::Profiler);
+
+		hz = hz > 0 ? hz : 1000;
+		profile.state = L;
+		profile.interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / hz));
+		profile.next_sample = std::chrono::steady_clock::now() + profile.interval;
+		profile.stacks.clear();
+
+		SolLuaHooks::Set(L, SolLuaHooks::Client::Profiler, &SolLuaProfiler::Hook);
+	}
+
+	Rml::String SolLuaProfiler::Stop()
+	{
+		auto& profile = getProfile();
+		if (profile.state != nullptr)
+		{
+			SolLuaHooks::Clear(profile.state, SolLuaHooks::Client::Profiler);
+			profile.state = nullptr;
+		}
+
+		Rml::String out;
+		for (const auto& [stack, count] : profile.stacks)
+		{
+			out.append(stack);
+			out.push_back(' ');
+			out.append(std::to_string(count));
+			out.push_back('\n');
+		}
+		profile.stacks.clear();
+		return out;
+	}
+
+	bool SolLuaProfiler::IsRunning()
+	{
+		return getProfile().state != nullptr;
+	}
+
+	void SolLuaProfiler::Hook(lua_State* L, lua_Debug* ar)
+	{
+		if (ar->event != LUA_HOOKCOUNT)
+			return;
+
+		auto& profile = getProfile();
+		const auto now = std::chrono::steady_clock::now();
+		if (now < profile.next_sample)
+			return;
+
+		profile.next_sample = now + profile.interval;
+		Sample(L);
+	}
+
+	void SolLuaProfiler::Sample(lua_State* L)
+	{
+		auto& profile = getProfile();
+
+		// Find the outermost frame, then walk back to the innermost so the stack reads root first.
+		int depth = 0;
+		lua_Debug ar;
+		while (depth < MaxDepth && lua_getstack(L, depth, &ar) != 0)
+			++depth;
+		if (depth == 0)
+			return;
+
+		auto& stack = profile.scratch;
+		stack.clear();
+
+		// The root frame names the document running the code, or the chunk outside any document.
+		if (auto document = SolLuaCallScope::GetDocument(); document != nullptr)
+		{
+			stack.push_back('[');
+			stack.append(document->GetSourceURL());
+			stack.push_back(']');
+		}
+		else if (lua_getstack(L, depth - 1, &ar) != 0 && lua_getinfo(L, "S", &ar) != 0)
+		{
+			stack.append(ar.short_src);
+		}
+		std::replace(stack.begin(), stack.end(), ' ', '_');
+		std::replace(stack.begin(), stack.end(), ';', '_');
+
+		for (int level = depth - 1; level >= 0; --level)
+		{
+			if (lua_getstack(L, level, &ar) == 0 || lua_getinfo(L, "Sn", &ar) == 0)
+				continue;
+
+			stack.push_back(';');
+			appendFrame(stack, ar);
+		}
+
+		++profile.stacks[stack];
+	}
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <RmlUi/Core/Types.h>
+
+#include <sol/sol.hpp>
+
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Sampling profiler for one Lua state.
+	/// A count hook (see SolLuaHooks) checks the clock every few instructions and records the Lua call stack at the requested rate.
+	/// The hook is only installed while profiling, so there is no cost otherwise.
+	/// </summary>
+	class SolLuaProfiler
+	{
+	public:
+		/// <summary>
+		/// Starts sampling a state, discarding previous samples.
+		/// Coroutines created before the call are not sampled.
+		/// </summary>
+		/// <param name="L">The Lua state.</param>
+		/// <param name="hz">Samples per second.</param>
+		static void Start(lua_State* L, int hz);
+
+		/// <summary>
+		/// Stops sampling.
+		/// </summary>
+		/// <returns>The samples as collapsed stacks, one "root;caller;callee count" line per distinct stack, for flamegraph tools.</returns>
+		static Rml::String Stop();
+
+		static bool IsRunning();
+
+	private:
+		static void Hook(lua_State* L, lua_Debug* ar);
+		static void Sample(lua_State* L);
+	};
+
+} // end namespace Rml::SolLua
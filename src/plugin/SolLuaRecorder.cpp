@@ -0,0 +1,305 @@
+#include "SolLuaRecorder.h"
+
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/SystemInterface.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+
+namespace Rml::SolLua
+{
+
+	bool SolLuaRecorder::s_recording = false;
+	bool SolLuaRecorder::s_measuring = false;
+
+	namespace
+	{
+		constexpr const char* Header = "# RmlSolLua recording 1\n";
+
+		struct Recording
+		{
+			Rml::String text;
+			Rml::UnorderedSet<Rml::Context*> contexts;
+			double lua_ms = 0.0;
+		};
+
+		Recording& getRecording()
+		{
+			static Recording recording;
+			return recording;
+		}
+
+		/// <summary>
+		/// Escapes spaces, control characters and '%' as %XX so every field is a single token.
+		/// </summary>
+		void appendEscaped(Rml::String& out, const Rml::String& str)
+		{
+			for (const char c : str)
+			{
+				const auto byte = static_cast<unsigned char>(c);
+				if (byte <= 0x20 || byte >= 0x7f || c == '%')
+				{
+					char escaped[4];
+					std::snprintf(escaped, sizeof(escaped), "%%%02X", byte);
+					out.append(escaped);
+				}
+				else
+				{
+					out.push_back(c);
+				}
+			}
+		}
+
+		Rml::String unescape(const Rml::String& str)
+		{
+			Rml::String out;
+			out.reserve(str.size());
+			for (std::size_t i = 0; i < str.size(); ++i)
+			{
+				if (str[i] == '%' && i + 2 < str.size())
+				{
+					out.push_back(static_cast<char>(std::strtol(str.substr(i + 1, 2).c_str(), nullptr, 16)));
+					i += 2;
+				}
+				else
+				{
+					out.push_back(str[i]);
+				}
+			}
+			return out;
+		}
+
+		/// <summary>
+		/// Splits on a delimiter, keeping empty fields.
+		/// </summary>
+		void split(Rml::StringList& out, const Rml::String& str, char delimiter)
+		{
+			std::size_t start = 0;
+			while (start <= str.size())
+			{
+				auto end = str.find(delimiter, start);
+				if (end == Rml::String::npos)
+					end = str.size();
+				out.emplace_back(str, start, end - start);
+				start = end + 1;
+			}
+		}
+
+		/// <summary>
+		/// Starts a line for a call on a context, declaring the context the first time it is seen.
+		/// </summary>
+		Rml::String& beginLine(Rml::Context& context, const char* call)
+		{
+			auto& recording = getRecording();
+			auto& text = recording.text;
+
+			if (recording.contexts.insert(&context).second)
+			{
+				const auto dimensions = context.GetDimensions();
+				text.append("context ");
+				appendEscaped(text, context.GetName());
+				text.append(" ");
+				text.append(std::to_string(dimensions.x));
+				text.append(" ");
+				text.append(std::to_string(dimensions.y));
+				text.append("\n");
+			}
+
+			text.append(call);
+			text.append(" ");
+			appendEscaped(text, context.GetName());
+			return text;
+		}
+
+		template <typename T>
+		void appendNumber(Rml::String& out, T value)
+		{
+			if constexpr (std::is_integral_v<T>)
+			{
+				out.append(std::to_string(value));
+			}
+			else
+			{
+				// Enough digits to read back the same value.
+				char buffer[32];
+				std::snprintf(buffer, sizeof(buffer), "%.17g", static_cast<double>(value));
+				out.append(buffer);
+			}
+		}
+
+		template <typename T>
+		T parseNumber(const Rml::String& str, T default_value)
+		{
+			char* end = nullptr;
+			T value;
+			if constexpr (std::is_integral_v<T>)
+				value = static_cast<T>(std::strtol(str.c_str(), &end, 10));
+			else
+				value = static_cast<T>(std::strtod(str.c_str(), &end));
+			return end != str.c_str() ? value : default_value;
+		}
+
+		template <typename... Args>
+		void writeLine(Rml::Context& context, const char* call, Args... args)
+		{
+			auto& text = beginLine(context, call);
+			((text.append(" "), appendNumber(text, args)), ...);
+			text.append("\n");
+		}
+	}
+
+	void SolLuaRecorder::Start()
+	{
+		auto& recording = getRecording();
+		recording.text = Header;
+		recording.contexts.clear();
+		s_recording = true;
+	}
+
+	Rml::String SolLuaRecorder::Stop()
+	{
+		auto& recording = getRecording();
+		s_recording = false;
+		recording.contexts.clear();
+		return std::move(recording.text);
+	}
+
+	void SolLuaRecorder::MouseMove(Rml::Context& context, int x, int y, int key_modifier_state)
+	{
+		writeLine(context, "move", x, y, key_modifier_state);
+	}
+
+	void SolLuaRecorder::MouseButton(Rml::Context& context, bool down, int button_index, int key_modifier_state)
+	{
+		writeLine(context, down ? "down" : "up", button_index, key_modifier_state);
+	}
+
+	void SolLuaRecorder::MouseWheel(Rml::Context& context, float delta_x, float delta_y, int key_modifier_state)
+	{
+		writeLine(context, "wheel", delta_x, delta_y, key_modifier_state);
+	}
+
+	void SolLuaRecorder::MouseLeave(Rml::Context& context)
+	{
+		writeLine(context, "leave");
+	}
+
+	void SolLuaRecorder::Key(Rml::Context& context, bool down, int key_identifier, int key_modifier_state)
+	{
+		writeLine(context, down ? "keydown" : "keyup", key_identifier, key_modifier_state);
+	}
+
+	void SolLuaRecorder::TextInput(Rml::Context& context, const Rml::String& text)
+	{
+		auto& line = beginLine(context, "text");
+		line.append(" ");
+		appendEscaped(line, text);
+		line.append("\n");
+	}
+
+	void SolLuaRecorder::Update(Rml::Context& context)
+	{
+		auto system = Rml::GetSystemInterface();
+		writeLine(context, "update", system != nullptr ? system->GetElapsedTime() : 0.0);
+	}
+
+	void SolLuaRecorder::AddLuaTime(double ms)
+	{
+		getRecording().lua_ms += ms;
+	}
+
+	Rml::Vector<ReplayFrame> SolLuaRecorder::Replay(const Rml::String& recording, const Rml::Function<void(double)>& set_time)
+	{
+		using clock = std::chrono::steady_clock;
+
+		Rml::Vector<ReplayFrame> frames;
+		auto& lua_ms = getRecording().lua_ms;
+		lua_ms = 0.0;
+		s_measuring = true;
+
+		Rml::StringList lines;
+		Rml::StringList tokens;
+		split(lines, recording, '\n');
+
+		auto frame_start = clock::now();
+		for (std::size_t number = 0; number < lines.size(); ++number)
+		{
+			const auto& line = lines[number];
+			if (line.empty() || line[0] == '#')
+				continue;
+
+			tokens.clear();
+			split(tokens, line, ' ');
+			if (tokens.size() < 2)
+			{
+				Rml::Log::Message(Rml::Log::LT_WARNING, "[LUA][REPLAY] Skipping malformed line %d: %s", static_cast<int>(number + 1), line.c_str());
+				continue;
+			}
+
+			const auto& call = tokens[0];
+			const auto name = unescape(tokens[1]);
+			auto arg = [&tokens](std::size_t index, auto default_value) {
+				return index < tokens.size() ? parseNumber(tokens[index], default_value) : default_value;
+			};
+
+			auto context = Rml::GetContext(name);
+			if (call == "context")
+			{
+				if (context == nullptr)
+					context = Rml::CreateContext(name, Rml::Vector2i(arg(2, 0), arg(3, 0)));
+				continue;
+			}
+
+			if (context == nullptr)
+			{
+				Rml::Log::Message(Rml::Log::LT_WARNING, "[LUA][REPLAY] Skipping line %d for unknown context '%s'.", static_cast<int>(number + 1), name.c_str());
+				continue;
+			}
+
+			if (call == "move")
+				context->ProcessMouseMove(arg(2, 0), arg(3, 0), arg(4, 0));
+			else if (call == "down")
+				context->ProcessMouseButtonDown(arg(2, 0), arg(3, 0));
+			else if (call == "up")
+				context->ProcessMouseButtonUp(arg(2, 0), arg(3, 0));
+			else if (call == "wheel")
+#if RmlUi_VERSION_MAJOR >= 5 && RmlUi_VERSION_MINOR >= 1
+				context->ProcessMouseWheel(Rml::Vector2f(arg(2, 0.f), arg(3, 0.f)), arg(4, 0));
+#else
+				context->ProcessMouseWheel(arg(3, 0.f), arg(4, 0));
+#endif
+			else if (call == "leave")
+				context->ProcessMouseLeave();
+			else if (call == "keydown")
+				context->ProcessKeyDown(static_cast<Rml::Input::KeyIdentifier>(arg(2, 0)), arg(3, 0));
+			else if (call == "keyup")
+				context->ProcessKeyUp(static_cast<Rml::Input::KeyIdentifier>(arg(2, 0)), arg(3, 0));
+			else if (call == "text")
+				context->ProcessTextInput(tokens.size() > 2 ? unescape(tokens[2]) : Rml::String{});
+			else if (call == "update")
+			{
+				const auto time = arg(2, 0.0);
+				if (set_time)
+					set_time(time);
+
+				context->Update();
+
+				const auto frame_end = clock::now();
+				frames.push_back({ time, std::chrono::duration<double, std::milli>(frame_end - frame_start).count(), lua_ms });
+				frame_start = frame_end;
+				lua_ms = 0.0;
+			}
+			else
+				Rml::Log::Message(Rml::Log::LT_WARNING, "[LUA][REPLAY] Skipping unknown call on line %d: %s", static_cast<int>(number + 1), call.c_str());
+		}
+
+		s_measuring = false;
+		return frames;
+	}
+
+} // end namespace Rml::SolLua
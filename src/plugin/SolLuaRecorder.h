@@ -0,0 +1,66 @@
+#pragma once
+
+#include "RmlSolLua/RmlSolLua.h"
+
+#include <RmlUi/Core/Types.h>
+
+
+namespace Rml
+{
+	class Context;
+}
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Records the input and updates that Lua sends to contexts as text, one call per line, and replays them.
+	/// Each update line stores the elapsed time RmlUi saw, so a replay can drive animations and timers with the same clock.
+	/// </summary>
+	class SolLuaRecorder
+	{
+	public:
+		static bool IsRecording() { return s_recording; }
+
+		/// <summary>
+		/// Starts recording, discarding a previous recording.
+		/// </summary>
+		static void Start();
+
+		/// <summary>
+		/// Stops recording.
+		/// </summary>
+		/// <returns>The recording.</returns>
+		static Rml::String Stop();
+
+		static void MouseMove(Rml::Context& context, int x, int y, int key_modifier_state);
+		static void MouseButton(Rml::Context& context, bool down, int button_index, int key_modifier_state);
+		static void MouseWheel(Rml::Context& context, float delta_x, float delta_y, int key_modifier_state);
+		static void MouseLeave(Rml::Context& context);
+		static void Key(Rml::Context& context, bool down, int key_identifier, int key_modifier_state);
+		static void TextInput(Rml::Context& context, const Rml::String& text);
+		static void Update(Rml::Context& context);
+
+		/// <summary>
+		/// Checks whether a replay is measuring the time spent in Lua.
+		/// </summary>
+		static bool IsMeasuring() { return s_measuring; }
+
+		/// <summary>
+		/// Adds time spent in Lua to the frame being replayed.
+		/// </summary>
+		static void AddLuaTime(double ms);
+
+		/// <summary>
+		/// Replays a recording into the contexts it names, creating missing contexts.
+		/// </summary>
+		/// <param name="recording">The recording.</param>
+		/// <param name="set_time">Called with the recorded elapsed time before each update, or empty.</param>
+		/// <returns>Timings of each update.</returns>
+		static Rml::Vector<ReplayFrame> Replay(const Rml::String& recording, const Rml::Function<void(double)>& set_time);
+
+	private:
+		static bool s_recording;
+		static bool s_measuring;
+	};
+
+} // end namespace Rml::SolLua
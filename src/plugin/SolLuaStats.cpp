@@ -0,0 +1,52 @@
+#include "SolLuaStats.h"
+
+#include "SolLuaDataModel.h"
+#include "SolLuaEventListener.h"
+
+#include <sol/sol.hpp>
+
+
+namespace Rml::SolLua
+{
+
+	namespace
+	{
+		RuntimeStats::Calls toCalls(const uint64_t (&counts)[static_cast<int>(SolLuaStats::CallType::Count)])
+		{
+			RuntimeStats::Calls calls;
+			calls.Scripts = counts[static_cast<int>(SolLuaStats::CallType::Script)];
+			calls.Listeners = counts[static_cast<int>(SolLuaStats::CallType::Listener)];
+			calls.DataEvents = counts[static_cast<int>(SolLuaStats::CallType::DataEvent)];
+			calls.DataModel = counts[static_cast<int>(SolLuaStats::CallType::DataModel)];
+			return calls;
+		}
+	}
+
+	void SolLuaStats::ResetFrame()
+	{
+		auto& counters = Get();
+		for (int i = 0; i < static_cast<int>(CallType::Count); ++i)
+		{
+			counters.LastFrame[i] = counters.Frame[i];
+			counters.Frame[i] = 0;
+		}
+	}
+
+	RuntimeStats SolLuaStats::Collect(lua_State* L)
+	{
+		const auto& counters = Get();
+
+		RuntimeStats stats;
+		stats.Listeners = static_cast<int64_t>(SolLuaEventListener::GetLiveCount());
+		stats.CompiledListeners = counters.CompiledListeners;
+		stats.Documents = counters.Documents;
+		stats.DataModels = static_cast<int64_t>(SolLuaDataModel::GetLiveCount());
+		stats.DataModelObjects = static_cast<int64_t>(SolLuaDataModel::GetLiveObjectCount());
+		stats.LuaHeapKB = L != nullptr ? lua_gc(L, LUA_GCCOUNT, 0) : 0;
+		stats.Frame = toCalls(counters.Frame);
+		stats.LastFrame = toCalls(counters.LastFrame);
+		stats.Total = toCalls(counters.Total);
+		return stats;
+	}
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "RmlSolLua/RmlSolLua.h"
+
+#include <cstdint>
+
+struct lua_State;
+
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Thread local runtime counters.  Lua runs on one thread, so the counters of that thread describe the whole library.
+	/// </summary>
+	class SolLuaStats
+	{
+	public:
+		enum class CallType
+		{
+			Script,
+			Listener,
+			DataEvent,
+			DataModel,
+			Count
+		};
+
+		struct Counters
+		{
+			int64_t Documents = 0;
+			int64_t CompiledListeners = 0;
+			uint64_t Frame[static_cast<int>(CallType::Count)] = {};
+			uint64_t LastFrame[static_cast<int>(CallType::Count)] = {};
+			uint64_t Total[static_cast<int>(CallType::Count)] = {};
+		};
+
+		static Counters& Get()
+		{
+			thread_local Counters counters;
+			return counters;
+		}
+
+		static void AddCall(CallType type)
+		{
+			auto& counters = Get();
+			++counters.Frame[static_cast<int>(type)];
+			++counters.Total[static_cast<int>(type)];
+		}
+
+		/// <summary>
+		/// Moves this frame's call counts to the last frame and starts a new frame.
+		/// </summary>
+		static void ResetFrame();
+
+		/// <summary>
+		/// Collects every counter.
+		/// </summary>
+		/// <param name="L">The Lua state to read the heap size from, or nullptr.</param>
+		static RuntimeStats Collect(lua_State* L);
+	};
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,218 @@
+#include "SolLuaTrace.h"
+
+#include <RmlUi/Core/ElementDocument.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+
+namespace Rml::SolLua
+{
+
+	std::atomic<bool> SolLuaTrace::s_enabled{ false };
+
+	namespace
+	{
+		constexpr std::size_t MaxNameLength = 64;
+		constexpr std::size_t NameWords = MaxNameLength / sizeof(uint64_t);
+
+		// The payload is made of relaxed atomics, so a reader racing a writer reads a torn span it then discards, rather than racing on plain memory.
+		struct Span
+		{
+			// 0 while unused, odd while being written, 2 * index + 2 once published.
+			std::atomic<uint64_t> sequence{ 0 };
+			std::atomic<uint64_t> start_us{ 0 };
+			std::atomic<uint64_t> duration_us{ 0 };
+			std::atomic<uint32_t> thread{ 0 };
+			std::atomic<uint64_t> label[NameWords] = {};
+			std::atomic<uint64_t> document[NameWords] = {};
+		};
+
+		struct Buffer
+		{
+			Rml::UniquePtr<Span[]> spans;
+			std::size_t mask = 0;
+			std::atomic<uint64_t> head{ 0 };
+			std::chrono::steady_clock::time_point origin;
+		};
+
+		Buffer& getBuffer()
+		{
+			static Buffer buffer;
+			return buffer;
+		}
+
+		void storeName(std::atomic<uint64_t> (&destination)[NameWords], const char* source, std::size_t length)
+		{
+			char name[MaxNameLength] = {};
+			std::memcpy(name, source, std::min(length, MaxNameLength - 1));
+			for (std::size_t i = 0; i < NameWords; ++i)
+			{
+				uint64_t word;
+				std::memcpy(&word, name + i * sizeof(word), sizeof(word));
+				destination[i].store(word, std::memory_order_relaxed);
+			}
+		}
+
+		void loadName(const std::atomic<uint64_t> (&source)[NameWords], char (&destination)[MaxNameLength])
+		{
+			for (std::size_t i = 0; i < NameWords; ++i)
+			{
+				const uint64_t word = source[i].load(std::memory_order_relaxed);
+				std::memcpy(destination + i * sizeof(word), &word, sizeof(word));
+			}
+		}
+
+		uint32_t getThreadId()
+		{
+			thread_local const auto id = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+			return id;
+		}
+
+		void appendEscaped(Rml::String& out, const char* str)
+		{
+			for (; *str != '\0'; ++str)
+			{
+				const char c = *str;
+				switch (c)
+				{
+				case '"': out.append("\\\""); break;
+				case '\\': out.append("\\\\"); break;
+				case '\n': out.append("\\n"); break;
+				case '\r': out.append("\\r"); break;
+				case '\t': out.append("\\t"); break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20)
+					{
+						char escaped[8];
+						std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+						out.append(escaped);
+					}
+					else
+					{
+						out.push_back(c);
+					}
+					break;
+				}
+			}
+		}
+	}
+
+	void SolLuaTrace::Enable(std::size_t capacity)
+	{
+		std::size_t size = 1;
+		while (size < capacity)
+			size <<= 1;
+
+		auto& buffer = getBuffer();
+		s_enabled.store(false);
+		buffer.spans = Rml::UniquePtr<Span[]>(new Span[size]);
+		buffer.mask = size - 1;
+		buffer.head.store(0);
+		buffer.origin = std::chrono::steady_clock::now();
+		s_enabled.store(true);
+	}
+
+	void SolLuaTrace::Disable()
+	{
+		s_enabled.store(false);
+	}
+
+	void SolLuaTrace::Record(const Rml::String& label, const Rml::ElementDocument* document, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+	{
+		using std::chrono::duration_cast;
+		using std::chrono::microseconds;
+
+		auto& buffer = getBuffer();
+		if (!buffer.spans)
+			return;
+
+		const auto index = buffer.head.fetch_add(1, std::memory_order_relaxed);
+		auto& span = buffer.spans[index & buffer.mask];
+
+		span.sequence.store(2 * index + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		span.start_us.store(static_cast<uint64_t>(duration_cast<microseconds>(start - buffer.origin).count()), std::memory_order_relaxed);
+		span.duration_us.store(static_cast<uint64_t>(duration_cast<microseconds>(end - start).count()), std::memory_order_relaxed);
+		span.thread.store(getThreadId(), std::memory_order_relaxed);
+		storeName(span.label, label.data(), label.size());
+		if (document != nullptr)
+		{
+			const auto& url = document->GetSourceURL();
+			storeName(span.document, url.data(), url.size());
+		}
+		else
+		{
+			storeName(span.document, "", 0);
+		}
+
+		span.sequence.store(2 * index + 2, std::memory_order_release);
+	}
+
+	Rml::String SolLuaTrace::Dump()
+	{
+		auto& buffer = getBuffer();
+
+		Rml::String out{ "{\"traceEvents\":[" };
+		if (buffer.spans)
+		{
+			const uint64_t head = buffer.head.load(std::memory_order_acquire);
+			const uint64_t capacity = buffer.mask + 1;
+			const uint64_t first = head > capacity ? head - capacity : 0;
+
+			bool comma = false;
+			struct
+			{
+				uint64_t start_us;
+				uint64_t duration_us;
+				uint32_t thread;
+				char label[MaxNameLength];
+				char document[MaxNameLength];
+			} copy;
+			for (uint64_t index = first; index < head; ++index)
+			{
+				const auto& span = buffer.spans[index & buffer.mask];
+
+				// Copy, then check the slot wasn't rewritten meanwhile.
+				const auto before = span.sequence.load(std::memory_order_acquire);
+				if (before != 2 * index + 2)
+					continue;
+				copy.start_us = span.start_us.load(std::memory_order_relaxed);
+				copy.duration_us = span.duration_us.load(std::memory_order_relaxed);
+				copy.thread = span.thread.load(std::memory_order_relaxed);
+				loadName(span.label, copy.label);
+				loadName(span.document, copy.document);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (span.sequence.load(std::memory_order_relaxed) != before)
+					continue;
+
+				copy.label[MaxNameLength - 1] = '\0';
+				copy.document[MaxNameLength - 1] = '\0';
+
+				if (comma)
+					out.append(",");
+				comma = true;
+
+				out.append("{\"name\":\"");
+				appendEscaped(out, copy.label);
+				out.append("\",\"cat\":\"lua\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+				out.append(std::to_string(copy.thread));
+				out.append(",\"ts\":");
+				out.append(std::to_string(copy.start_us));
+				out.append(",\"dur\":");
+				out.append(std::to_string(copy.duration_us));
+				out.append(",\"args\":{\"document\":\"");
+				appendEscaped(out, copy.document);
+				out.append("\"}}");
+			}
+		}
+		out.append("],\"displayTimeUnit\":\"ms\"}");
+		return out;
+	}
+
+} // end namespace Rml::SolLua
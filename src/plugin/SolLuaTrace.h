@@ -0,0 +1,53 @@
+#pragma once
+
+#include <RmlUi/Core/Types.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+
+namespace Rml
+{
+	class ElementDocument;
+}
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Records every labelled SolLuaCallScope as a span in a fixed size ring buffer and dumps them as Chrome trace event JSON.
+	/// Writers claim slots with an atomic counter and publish them with a sequence number, so recording never takes a lock
+	/// and a dump taken while Lua is running skips the slots being written.
+	/// </summary>
+	class SolLuaTrace
+	{
+	public:
+		static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+		/// <summary>
+		/// Starts recording, discarding previous spans.
+		/// Call it from the thread that runs Lua, while no Lua code is running.
+		/// </summary>
+		/// <param name="capacity">Number of spans kept.  Rounded up to a power of two.</param>
+		static void Enable(std::size_t capacity);
+
+		/// <summary>
+		/// Stops recording.  The recorded spans can still be dumped.
+		/// </summary>
+		static void Disable();
+
+		/// <summary>
+		/// Records a span.
+		/// </summary>
+		static void Record(const Rml::String& label, const Rml::ElementDocument* document, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+		/// <summary>
+		/// Writes the recorded spans, oldest first, as a Chrome/Perfetto trace event JSON document.
+		/// </summary>
+		static Rml::String Dump();
+
+	private:
+		static std::atomic<bool> s_enabled;
+	};
+
+} // end namespace Rml::SolLua
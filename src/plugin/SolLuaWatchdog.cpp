@@ -0,0 +1,118 @@
+#include "SolLuaWatchdog.h"
+
+#include "SolLuaHooks.h"
+
+#include <cstdio>
+
+
+namespace Rml::SolLua
+{
+
+	bool SolLuaWatchdog::s_enabled = false;
+
+	namespace
+	{
+		struct Watch
+		{
+			uint64_t max_instructions = 0;
+			std::chrono::steady_clock::duration max_time{};
+			int disable_after = 0;
+
+			// The running call.
+			lua_State* state = nullptr;
+			SolLuaWatchdog::Scope* current = nullptr;
+			uint64_t instructions = 0;
+			std::chrono::steady_clock::time_point deadline;
+		};
+
+		Watch& getWatch()
+		{
+			static Watch watch;
+			return watch;
+		}
+	}
+
+	void SolLuaWatchdog::Enable(uint64_t max_instructions, double max_ms, int disable_after)
+	{
+		auto& watch = getWatch();
+		watch.max_instructions = max_instructions;
+		watch.max_time = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(max_ms));
+		watch.disable_after = disable_after;
+		s_enabled = max_instructions != 0 || max_ms > 0.0;
+	}
+
+	void SolLuaWatchdog::Disable()
+	{
+		s_enabled = false;
+	}
+
+	int SolLuaWatchdog::GetDisableAfter()
+	{
+		return getWatch().disable_after;
+	}
+
+	SolLuaWatchdog::Scope::Scope(lua_State* L, const Rml::String* label)
+		: m_active(s_enabled), m_label(label)
+	{
+		if (!m_active)
+			return;
+
+		auto& watch = getWatch();
+		m_previous = watch.current;
+		watch.current = this;
+
+		if (m_previous != nullptr)
+			return;
+
+		watch.state = L;
+		watch.instructions = 0;
+		watch.deadline = std::chrono::steady_clock::now() + watch.max_time;
+		SolLuaHooks::Set(L, SolLuaHooks::Client::Watchdog, &SolLuaWatchdog::Hook);
+	}
+
+	SolLuaWatchdog::Scope::~Scope()
+	{
+		if (!m_active)
+			return;
+
+		auto& watch = getWatch();
+		watch.current = m_previous;
+
+		if (m_previous == nullptr)
+		{
+			SolLuaHooks::Clear(watch.state, SolLuaHooks::Client::Watchdog);
+			watch.state = nullptr;
+		}
+	}
+
+	void SolLuaWatchdog::Hook(lua_State* L, lua_Debug* ar)
+	{
+		if (ar->event != LUA_HOOKCOUNT)
+			return;
+
+		auto& watch = getWatch();
+		if (watch.current == nullptr)
+			return;
+
+		watch.instructions += SolLuaHooks::Interval;
+		const bool over_instructions = watch.max_instructions != 0 && watch.instructions > watch.max_instructions;
+		const bool over_time = watch.max_time.count() > 0 && std::chrono::steady_clock::now() > watch.deadline;
+		if (!over_instructions && !over_time)
+			return;
+
+		auto scope = watch.current;
+		scope->m_tripped = true;
+
+		// lua_error doesn't return and may longjmp, so nothing here may need destruction.
+		char message[256];
+		const char* label = scope->m_label != nullptr && !scope->m_label->empty() ? scope->m_label->c_str() : "Lua handler";
+		if (over_instructions)
+			std::snprintf(message, sizeof(message), "[WATCHDOG] %s exceeded its budget of %llu instructions.", label, static_cast<unsigned long long>(watch.max_instructions));
+		else
+			std::snprintf(message, sizeof(message), "[WATCHDOG] %s exceeded its budget of %.2f ms.", label, std::chrono::duration<double, std::milli>(watch.max_time).count());
+
+		lua_pushstring(L, message);
+		lua_error(L);
+	}
+
+} // end namespace Rml::SolLua
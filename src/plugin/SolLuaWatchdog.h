@@ -0,0 +1,72 @@
+#pragma once
+
+#include <RmlUi/Core/Types.h>
+
+#include <sol/sol.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+
+namespace Rml::SolLua
+{
+	/// <summary>
+	/// Aborts event handlers that run past an instruction or time budget.
+	/// A count hook (see SolLuaHooks) is installed only while a watched handler runs and raises a Lua error once the budget is spent,
+	/// so the handler's protected call fails and the error is reported through ErrorHandler.
+	/// Code compiled by the LuaJIT trace compiler doesn't run count hooks, so compiled loops are only stopped once they leave the trace.
+	/// The budget error is an ordinary Lua error: a handler that calls pcall around the looping code catches it and keeps running,
+	/// and the hook raises it again every SolLuaHooks::Interval instructions until the handler returns.
+	/// </summary>
+	class SolLuaWatchdog
+	{
+	public:
+		static bool IsEnabled() { return s_enabled; }
+
+		/// <summary>
+		/// Sets the budget of each watched call.  A zero limit is not checked.
+		/// </summary>
+		/// <param name="max_instructions">Instructions per call, counted in steps of SolLuaHooks::Interval.</param>
+		/// <param name="max_ms">Time per call in milliseconds.</param>
+		/// <param name="disable_after">Budget overruns after which an event listener is disabled.  0 never disables.</param>
+		static void Enable(uint64_t max_instructions, double max_ms, int disable_after);
+
+		static void Disable();
+
+		static int GetDisableAfter();
+
+		/// <summary>
+		/// Watches the Lua code run during its lifetime.  Nested scopes share the budget of the outermost one.
+		/// </summary>
+		class Scope
+		{
+		public:
+			/// <param name="L">The Lua state running the handler.</param>
+			/// <param name="label">Names the handler in the error.  Must outlive the scope.</param>
+			Scope(lua_State* L, const Rml::String* label);
+			~Scope();
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+			/// <summary>
+			/// Checks whether the budget ran out while this scope's handler was the innermost one running.
+			/// </summary>
+			bool Tripped() const { return m_tripped; }
+
+		private:
+			friend class SolLuaWatchdog;
+
+			bool m_active;
+			bool m_tripped = false;
+			const Rml::String* m_label;
+			Scope* m_previous = nullptr;
+		};
+
+	private:
+		static void Hook(lua_State* L, lua_Debug* ar);
+
+		static bool s_enabled;
+	};
+
+} // end namespace Rml::SolLua
@@ -0,0 +1,209 @@
+#include "plugin/SolLuaBundle.h"
+
+#include <lua.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+	namespace fs = std::filesystem;
+	namespace Bundle = Rml::SolLua::Bundle;
+
+	constexpr const char* Usage =
+		"Usage: RmlSolLua_pack <bundle> [options] <files or directories>...\n"
+		"  --root <dir>   Paths in the bundle are relative to this directory, and must match the paths the program opens.\n"
+		"                 Default: the current directory.\n"
+		"  --source       Stores .lua files as source instead of bytecode.\n"
+		"  --strip        Drops debug info from bytecode.  Lua errors then have no line numbers.\n"
+		"Bytecode only loads in the Lua build it was compiled with, so build this tool against the program's Lua.\n";
+
+	struct File
+	{
+		std::string path;
+		uint32_t flags = 0;
+		std::string contents;
+	};
+
+	bool readFile(const fs::path& path, std::string& out)
+	{
+		std::ifstream stream{ path, std::ios::binary };
+		if (!stream)
+		{
+			std::fprintf(stderr, "Can't read %s\n", path.string().c_str());
+			return false;
+		}
+		out.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	int writer(lua_State*, const void* p, size_t size, void* ud)
+	{
+		static_cast<std::string*>(ud)->append(static_cast<const char*>(p), size);
+		return 0;
+	}
+
+	/// <summary>
+	/// Compiles a Lua file with the chunk name the runtime uses, so errors name the same file.
+	/// </summary>
+	bool compile(lua_State* L, File& file, bool strip)
+	{
+		const std::string chunkname = "@" + file.path;
+		if (luaL_loadbuffer(L, file.contents.data(), file.contents.size(), chunkname.c_str()) != 0)
+		{
+			std::fprintf(stderr, "%s\n", lua_tostring(L, -1));
+			lua_pop(L, 1);
+			return false;
+		}
+
+		std::string bytecode;
+#if LUA_VERSION_NUM >= 503
+		lua_dump(L, &writer, &bytecode, strip ? 1 : 0);
+#else
+		if (strip)
+			std::fprintf(stderr, "This Lua can't strip debug info, keeping it for %s\n", file.path.c_str());
+		lua_dump(L, &writer, &bytecode);
+#endif
+		lua_pop(L, 1);
+
+		file.contents = std::move(bytecode);
+		file.flags |= Bundle::Bytecode;
+		return true;
+	}
+
+	bool addFile(std::vector<File>& files, const fs::path& path, const fs::path& root)
+	{
+		std::error_code error;
+		const auto relative = fs::relative(path, root, error);
+		const auto bundle_path = relative.generic_string();
+		if (error || bundle_path.empty() || bundle_path.compare(0, 2, "..") == 0)
+		{
+			std::fprintf(stderr, "%s is not under the root directory\n", path.string().c_str());
+			return false;
+		}
+
+		File file;
+		file.path = bundle_path;
+		if (!readFile(path, file.contents))
+			return false;
+
+		files.push_back(std::move(file));
+		return true;
+	}
+
+	std::string write(const std::vector<File>& files)
+	{
+		auto align = [](std::size_t offset) { return (offset + Bundle::Alignment - 1) / Bundle::Alignment * Bundle::Alignment; };
+
+		std::size_t index_size = 0;
+		for (const auto& file : files)
+			index_size += Bundle::EntrySize + file.path.size();
+
+		std::string out;
+		out.append(Bundle::Magic, sizeof(Bundle::Magic));
+		Bundle::Write<uint32_t>(out, Bundle::Version);
+		Bundle::Write<uint32_t>(out, static_cast<uint32_t>(files.size()));
+		Bundle::Write<uint32_t>(out, static_cast<uint32_t>(index_size));
+
+		std::size_t offset = align(Bundle::HeaderSize + index_size);
+		for (const auto& file : files)
+		{
+			Bundle::Write<uint32_t>(out, static_cast<uint32_t>(file.path.size()));
+			Bundle::Write<uint32_t>(out, file.flags);
+			Bundle::Write<uint64_t>(out, offset);
+			Bundle::Write<uint64_t>(out, file.contents.size());
+			out.append(file.path);
+			offset = align(offset + file.contents.size());
+		}
+
+		for (const auto& file : files)
+		{
+			out.resize(align(out.size()), '\0');
+			out.append(file.contents);
+		}
+		return out;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::fputs(Usage, stderr);
+		return 1;
+	}
+
+	const char* bundle_path = argv[1];
+	fs::path root = fs::current_path();
+	bool source = false;
+	bool strip = false;
+	std::vector<fs::path> inputs;
+
+	for (int i = 2; i < argc; ++i)
+	{
+		if (i + 1 < argc && std::strcmp(argv[i], "--root") == 0)
+			root = argv[++i];
+		else if (std::strcmp(argv[i], "--source") == 0)
+			source = true;
+		else if (std::strcmp(argv[i], "--strip") == 0)
+			strip = true;
+		else if (argv[i][0] == '-')
+		{
+			std::fputs(Usage, stderr);
+			return 1;
+		}
+		else
+			inputs.emplace_back(argv[i]);
+	}
+
+	std::vector<File> files;
+	for (const auto& input : inputs)
+	{
+		if (fs::is_directory(input))
+		{
+			for (const auto& entry : fs::recursive_directory_iterator(input))
+			{
+				if (entry.is_regular_file() && !addFile(files, entry.path(), root))
+					return 1;
+			}
+		}
+		else if (!addFile(files, input, root))
+			return 1;
+	}
+
+	// Sorted, so the same inputs make the same bundle.
+	std::sort(files.begin(), files.end(), [](const File& a, const File& b) { return a.path < b.path; });
+	files.erase(std::unique(files.begin(), files.end(), [](const File& a, const File& b) { return a.path == b.path; }), files.end());
+
+	if (!source)
+	{
+		lua_State* L = luaL_newstate();
+		for (auto& file : files)
+		{
+			if (fs::path(file.path).extension() == ".lua" && !compile(L, file, strip))
+			{
+				lua_close(L);
+				return 1;
+			}
+		}
+		lua_close(L);
+	}
+
+	std::ofstream stream{ bundle_path, std::ios::binary };
+	const auto bundle = write(files);
+	if (!stream.write(bundle.data(), static_cast<std::streamsize>(bundle.size())))
+	{
+		std::fprintf(stderr, "Can't write %s\n", bundle_path);
+		return 1;
+	}
+
+	std::printf("%zu files, %zu bytes\n", files.size(), bundle.size());
+	return 0;
+}